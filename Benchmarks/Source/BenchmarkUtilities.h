@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+    BenchmarkUtilities.h
+
+    Timing helpers shared by the benchmark suites.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace Benchmark
+{
+    // Amount of audio pushed through every measurement, independent of the block size
+    constexpr int samplesPerMeasurement = 1 << 20;
+
+    inline void fillWithNoise(juce::AudioBuffer<float>& buffer, juce::Random& random)
+    {
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        {
+            auto* samples = buffer.getWritePointer(channel);
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                samples[i] = random.nextFloat() * 2.0f - 1.0f;
+        }
+    }
+
+    // Runs processBlock over samplesPerMeasurement samples in blocks of buffer.getNumSamples()
+    // and returns the cost per sample frame in nanoseconds
+    template <typename ProcessFunction>
+    double measureNsPerSample(juce::AudioBuffer<float>& buffer, ProcessFunction&& processBlock)
+    {
+        juce::Random random(0x5eed);
+        fillWithNoise(buffer, random);
+
+        auto numBlocks = juce::jmax(1, samplesPerMeasurement / buffer.getNumSamples());
+
+        // Warm up caches and branch predictors
+        for (int i = 0; i < juce::jmin(numBlocks, 64); ++i)
+            processBlock(buffer);
+
+        auto start = juce::Time::getHighResolutionTicks();
+
+        for (int i = 0; i < numBlocks; ++i)
+            processBlock(buffer);
+
+        auto seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+        return seconds * 1.0e9 / ((double) numBlocks * buffer.getNumSamples());
+    }
+
+    inline void printResult(const juce::String& name, int blockSize, double nsPerSample, const juce::String& details = {})
+    {
+        std::cout << name.paddedRight(' ', 40) << " block " << juce::String(blockSize).paddedLeft(' ', 5)
+                  << "  " << juce::String(nsPerSample, 2).paddedLeft(' ', 8) << " ns/sample"
+                  << (details.isEmpty() ? "" : "  " + details) << std::endl;
+    }
+}
@@ -0,0 +1,102 @@
+/*
+  ==============================================================================
+
+    ChannelBenchmarks.cpp
+
+  ==============================================================================
+*/
+
+#include "ChannelBenchmarks.h"
+#include "BenchmarkUtilities.h"
+#include "../../Source/PluginProcessor.h"
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 256;
+    constexpr std::array<int, 3> channelCounts{ 2, 8, 16 };
+
+    double measureProcessBlock(int numChannels, ReverbEngine engine)
+    {
+        SimplePluginAudioProcessor processor;
+
+        auto* parameter = processor.apvts.getParameter(ParameterIDs::reverbEngine);
+        parameter->setValueNotifyingHost(parameter->convertTo0to1((float) engine));
+
+        processor.setPlayConfigDetails(numChannels, numChannels, sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+
+        juce::AudioBuffer<float> buffer(numChannels, blockSize);
+        juce::MidiBuffer midiMessages;
+
+        auto nsPerSample = Benchmark::measureNsPerSample(buffer, [&](juce::AudioBuffer<float>& block)
+        {
+            processor.processBlock(block, midiMessages);
+        });
+
+        processor.releaseResources();
+        return nsPerSample;
+    }
+
+    double measureFilterChain(int numChannels)
+    {
+        ChainSettings settings;
+        settings.lowCutFreq = 80.0f;
+        settings.highCutFreq = 12000.0f;
+        settings.peakFreq = 750.0f;
+        settings.peakGainInDecibels = 6.0f;
+        settings.lowCutSlope = Slope_24;
+        settings.highCutSlope = Slope_24;
+
+        ChainCoefficients coefficients;
+        CoefficientDesigner::design(coefficients, settings, sampleRate, CoefficientDesigner::allStages);
+
+        MultichannelFilterChain chain;
+        chain.prepare({ sampleRate, (juce::uint32) blockSize, (juce::uint32) numChannels });
+        chain.setCoefficients(coefficients);
+
+        juce::AudioBuffer<float> buffer(numChannels, blockSize);
+
+        return Benchmark::measureNsPerSample(buffer, [&](juce::AudioBuffer<float>& block)
+        {
+            juce::dsp::AudioBlock<float> audioBlock(block);
+            chain.process(juce::dsp::ProcessContextReplacing<float>(audioBlock));
+        });
+    }
+
+    double measureFeedbackDelayNetwork(int numChannels)
+    {
+        CustomReverb reverb;
+        reverb.setParameters(0.5f, 0.5f, 1.0f, 0.0f);
+        reverb.prepare({ sampleRate, (juce::uint32) blockSize, (juce::uint32) numChannels });
+
+        juce::AudioBuffer<float> buffer(numChannels, blockSize);
+
+        return Benchmark::measureNsPerSample(buffer, [&](juce::AudioBuffer<float>& block)
+        {
+            juce::dsp::AudioBlock<float> audioBlock(block);
+            reverb.process(juce::dsp::ProcessContextReplacing<float>(audioBlock));
+        });
+    }
+
+    void printPerChannel(const juce::String& name, int numChannels, double nsPerFrame)
+    {
+        Benchmark::printResult(name + ", " + juce::String(numChannels) + " ch", blockSize, nsPerFrame / numChannels,
+                               "per channel (" + juce::String(nsPerFrame, 2) + " ns/frame)");
+    }
+}
+
+void runChannelBenchmarks()
+{
+    std::cout << "=== Cost per channel at " << sampleRate << " Hz ===" << std::endl;
+
+    for (auto numChannels : channelCounts)
+    {
+        printPerChannel("processBlock Freeverb", numChannels, measureProcessBlock(numChannels, ReverbEngine::Freeverb));
+        printPerChannel("processBlock FDN", numChannels, measureProcessBlock(numChannels, ReverbEngine::FeedbackDelayNetwork));
+
+        // Channels share SIMD lanes, so the EQ's cost per channel drops until every register is full
+        printPerChannel("EQ 24 dB/Oct", numChannels, measureFilterChain(numChannels));
+        printPerChannel("FDN", numChannels, measureFeedbackDelayNetwork(numChannels));
+    }
+}
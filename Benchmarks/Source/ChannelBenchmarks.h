@@ -0,0 +1,12 @@
+/*
+  ==============================================================================
+
+    ChannelBenchmarks.h
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Cost per channel of processBlock and the channel-generic stages at 2, 8 and 16 channels
+void runChannelBenchmarks();
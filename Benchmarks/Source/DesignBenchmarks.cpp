@@ -0,0 +1,191 @@
+/*
+  ==============================================================================
+
+    DesignBenchmarks.cpp
+
+  ==============================================================================
+*/
+
+#include "DesignBenchmarks.h"
+#include "BenchmarkUtilities.h"
+#include "../../Source/ButterworthTable.h"
+#include "../../Source/CoefficientDesigner.h"
+
+namespace
+{
+    constexpr int numCutoffs = 2000;
+
+    // Magnitude of a cascade of normalised sections at one frequency, in double
+    template <typename Section>
+    double getMagnitude(const Section* sections, int numSections, double frequency, double sampleRate)
+    {
+        auto z = std::polar(1.0, -juce::MathConstants<double>::twoPi * frequency / sampleRate);
+        std::complex<double> response(1.0);
+
+        for (int i = 0; i < numSections; ++i)
+        {
+            const auto& s = sections[i];
+            response *= ((double) s.b0 + (double) s.b1 * z + (double) s.b2 * z * z) / (1.0 + (double) s.a1 * z + (double) s.a2 * z * z);
+        }
+
+        return std::abs(response);
+    }
+
+    template <typename FloatType>
+    std::vector<ButterworthTable::Section> designExact(bool highpass, double frequency, double sampleRate, Slope slope)
+    {
+        using Design = juce::dsp::FilterDesign<FloatType>;
+
+        auto order = 2 * (slope + 1);
+        auto designed = highpass ? Design::designIIRHighpassHighOrderButterworthMethod((FloatType) frequency, sampleRate, order)
+                                 : Design::designIIRLowpassHighOrderButterworthMethod((FloatType) frequency, sampleRate, order);
+
+        std::vector<ButterworthTable::Section> sections;
+
+        for (const auto& section : designed)
+        {
+            auto* raw = section->getRawCoefficients();
+            sections.push_back({ raw[0], raw[1], raw[2], raw[3], raw[4] });
+        }
+
+        return sections;
+    }
+
+    // Largest deviations in dB from the exact design in double, over the part of its response above -20 dB
+    struct Errors
+    {
+        double table{ 0.0 };             // Interpolation at full precision, what maxErrorDecibels bounds
+        double tableInFloat{ 0.0 };      // What the filters get, bounded by designInFloat + maxErrorDecibels
+        double designInFloat{ 0.0 };     // FilterDesign<float>, the path the table replaces
+    };
+
+    // Log-spaced cut-offs that mostly fall between grid points
+    Errors measureWorstErrors(const ButterworthTable& table, double sampleRate, bool highpass, Slope slope)
+    {
+        auto highestFrequency = juce::jmin((double) ButterworthTable::maxFrequency, sampleRate * 0.49);
+        auto numSections = slope + 1;
+        Errors worst;
+
+        for (int i = 0; i < numCutoffs; ++i)
+        {
+            // The table looks up a float cut-off, so the references use the same one
+            auto cutoff = (float) (ButterworthTable::minFrequency * std::pow(highestFrequency / ButterworthTable::minFrequency, (i + 0.5) / numCutoffs));
+
+            std::array<ButterworthTable::Section, ChainCoefficients::maxCutSections> interpolated;
+            std::array<BiquadCoefficients, ChainCoefficients::maxCutSections> interpolatedInFloat;
+
+            auto found = highpass ? table.getHighpass(cutoff, slope, interpolated.data()) && table.getHighpass(cutoff, slope, interpolatedInFloat.data())
+                                  : table.getLowpass(cutoff, slope, interpolated.data()) && table.getLowpass(cutoff, slope, interpolatedInFloat.data());
+            jassert(found);
+            juce::ignoreUnused(found);
+
+            auto exact = designExact<double>(highpass, cutoff, sampleRate, slope);
+            auto exactInFloat = designExact<float>(highpass, cutoff, sampleRate, slope);
+
+            for (int point = 0; point < 64; ++point)
+            {
+                auto frequency = 10.0 * std::pow(sampleRate * 0.4999 / 10.0, point / 63.0);
+                auto exactMagnitude = getMagnitude(exact.data(), numSections, frequency, sampleRate);
+
+                if (exactMagnitude < 0.1)
+                    continue;
+
+                auto getError = [&](auto* sections)
+                {
+                    return std::abs(juce::Decibels::gainToDecibels(getMagnitude(sections, numSections, frequency, sampleRate) / exactMagnitude, -200.0));
+                };
+
+                worst.table = juce::jmax(worst.table, getError(interpolated.data()));
+                worst.tableInFloat = juce::jmax(worst.tableInFloat, getError(interpolatedInFloat.data()));
+                worst.designInFloat = juce::jmax(worst.designInFloat, getError(exactInFloat.data()));
+            }
+        }
+
+        return worst;
+    }
+
+    // Nanoseconds per redesign of both cut filters while a cut-off sweeps, like automation would
+    double measureDesignNs(double sampleRate, Slope slope, const ButterworthTable* table)
+    {
+        constexpr int numDesigns = 20000;
+
+        ChainSettings settings;
+        settings.lowCutSlope = slope;
+        settings.highCutSlope = slope;
+
+        ChainCoefficients coefficients;
+        auto stages = (uint32_t) (CoefficientDesigner::lowCutStage | CoefficientDesigner::highCutStage);
+
+        auto start = juce::Time::getHighResolutionTicks();
+
+        for (int i = 0; i < numDesigns; ++i)
+        {
+            auto position = (float) (i % 1000) / 1000.0f;
+            settings.lowCutFreq = 30.0f * std::pow(20.0f, position);
+            settings.highCutFreq = 1000.0f * std::pow(15.0f, position);
+
+            CoefficientDesigner::design(coefficients, settings, sampleRate, stages, table);
+        }
+
+        auto seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+        return seconds * 1.0e9 / numDesigns;
+    }
+}
+
+bool runDesignBenchmarks()
+{
+    auto withinBound = true;
+
+    std::cout << "=== Butterworth table: interpolation error against FilterDesign ===" << std::endl;
+
+    for (auto sampleRate : { 44100.0, 48000.0, 96000.0, 192000.0 })
+    {
+        ButterworthTable table(sampleRate);
+
+        for (auto slope : { Slope_12, Slope_24, Slope_36, Slope_48 })
+        {
+            auto lowCut = measureWorstErrors(table, sampleRate, true, slope);
+            auto highCut = measureWorstErrors(table, sampleRate, false, slope);
+            auto tableError = juce::jmax(lowCut.table, highCut.table);
+            auto tableInFloatError = juce::jmax(lowCut.tableInFloat, highCut.tableInFloat);
+            auto designInFloatError = juce::jmax(lowCut.designInFloat, highCut.designInFloat);
+
+            // The shipped float sections may be no worse than designing in float, plus the interpolation bound
+            auto floatBound = designInFloatError + ButterworthTable::maxErrorDecibels;
+
+            auto passed = tableError <= ButterworthTable::maxErrorDecibels;
+            auto passedInFloat = tableInFloatError <= floatBound;
+
+            withinBound = withinBound && passed && passedInFloat;
+
+            std::cout << (juce::String(sampleRate, 0) + " Hz, " + juce::String(12 * (slope + 1)) + " dB/Oct").paddedRight(' ', 28)
+                      << " table " << juce::String(tableError, 4) << " dB " << (passed ? "ok" : "EXCEEDS BOUND")
+                      << "  in float " << juce::String(tableInFloatError, 3) << " dB of " << juce::String(floatBound, 3)
+                      << " dB " << (passedInFloat ? "ok" : "EXCEEDS BOUND")
+                      << ", FilterDesign<float> " << juce::String(designInFloatError, 3)
+                      << " dB  " << table.getNumPoints() << " points" << std::endl;
+        }
+    }
+
+    std::cout << "=== Cut filter redesign while automating, FilterDesign vs. table ===" << std::endl;
+
+    for (auto sampleRate : { 48000.0 })
+    {
+        ButterworthTable table(sampleRate);
+
+        for (auto slope : { Slope_12, Slope_24, Slope_36, Slope_48 })
+        {
+            auto slopeName = juce::String(12 * (slope + 1)) + " dB/Oct";
+
+            std::cout << ("FilterDesign, " + slopeName).paddedRight(' ', 40)
+                      << juce::String(measureDesignNs(sampleRate, slope, nullptr), 1).paddedLeft(' ', 9) << " ns per update" << std::endl;
+            std::cout << ("ButterworthTable, " + slopeName).paddedRight(' ', 40)
+                      << juce::String(measureDesignNs(sampleRate, slope, &table), 1).paddedLeft(' ', 9) << " ns per update" << std::endl;
+        }
+
+        std::cout << "Table size " << (int) (table.getSizeInBytes() / 1024) << " KB, shared by every instance at "
+                  << sampleRate << " Hz" << std::endl;
+    }
+
+    return withinBound;
+}
@@ -0,0 +1,14 @@
+/*
+  ==============================================================================
+
+    DesignBenchmarks.h
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Cost of designing the cut filters with FilterDesign against interpolating them from a ButterworthTable.
+// Also checks the interpolated responses against the exact designs; returns false if one exceeds
+// ButterworthTable::maxErrorDecibels.
+bool runDesignBenchmarks();
@@ -0,0 +1,278 @@
+/*
+  ==============================================================================
+
+    FilterBenchmarks.cpp
+
+  ==============================================================================
+*/
+
+#include "FilterBenchmarks.h"
+#include "BenchmarkUtilities.h"
+#include "../../Source/ControlRateSmoother.h"
+#include "../../Source/MultichannelFilterChain.h"
+#include "../../Source/SvfFilterChain.h"
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+
+    // The per-channel chain the processor used before MultichannelFilterChain
+    using Filter = juce::dsp::IIR::Filter<float>;
+    using CutFilter = juce::dsp::ProcessorChain<Filter, Filter, Filter, Filter>;
+    using MonoChain = juce::dsp::ProcessorChain<CutFilter, Filter, CutFilter>;
+
+    enum ChainPositions
+    {
+        LowCut,
+        Peak,
+        HighCut
+    };
+
+    template <int Index>
+    void setCutSection(CutFilter& cutFilter, const BiquadCoefficients& coefficients, int numSections)
+    {
+        cutFilter.get<Index>().coefficients = new juce::dsp::IIR::Coefficients<float>(coefficients.b0, coefficients.b1, coefficients.b2, 1.0f, coefficients.a1, coefficients.a2);
+        cutFilter.setBypassed<Index>(Index >= numSections);
+    }
+
+    void setCutFilter(CutFilter& cutFilter, const std::array<BiquadCoefficients, ChainCoefficients::maxCutSections>& coefficients, Slope slope)
+    {
+        setCutSection<0>(cutFilter, coefficients[0], slope + 1);
+        setCutSection<1>(cutFilter, coefficients[1], slope + 1);
+        setCutSection<2>(cutFilter, coefficients[2], slope + 1);
+        setCutSection<3>(cutFilter, coefficients[3], slope + 1);
+    }
+
+    void setMonoChain(MonoChain& chain, const ChainCoefficients& coefficients)
+    {
+        const auto& peak = coefficients.peak;
+
+        setCutFilter(chain.get<LowCut>(), coefficients.lowCut, coefficients.lowCutSlope);
+        chain.get<Peak>().coefficients = new juce::dsp::IIR::Coefficients<float>(peak.b0, peak.b1, peak.b2, 1.0f, peak.a1, peak.a2);
+        setCutFilter(chain.get<HighCut>(), coefficients.highCut, coefficients.highCutSlope);
+    }
+
+    // Moved settings put every cut-off and the peak somewhere else, for measuring glides
+    ChainCoefficients designChain(Slope lowCutSlope, Slope highCutSlope, bool moved = false)
+    {
+        ChainSettings settings;
+        settings.lowCutFreq = moved ? 120.0f : 80.0f;
+        settings.highCutFreq = moved ? 8000.0f : 12000.0f;
+        settings.peakFreq = moved ? 1500.0f : 750.0f;
+        settings.peakGainInDecibels = moved ? 12.0f : 6.0f;
+        settings.lowCutSlope = lowCutSlope;
+        settings.highCutSlope = highCutSlope;
+
+        ChainCoefficients coefficients;
+        CoefficientDesigner::design(coefficients, settings, sampleRate, CoefficientDesigner::allStages);
+        return coefficients;
+    }
+
+    double measureMonoChains(const ChainCoefficients& coefficients, int blockSize)
+    {
+        MonoChain leftChain, rightChain;
+        setMonoChain(leftChain, coefficients);
+        setMonoChain(rightChain, coefficients);
+
+        juce::dsp::ProcessSpec spec{ sampleRate, (juce::uint32) blockSize, 1 };
+        leftChain.prepare(spec);
+        rightChain.prepare(spec);
+
+        juce::AudioBuffer<float> buffer(2, blockSize);
+
+        return Benchmark::measureNsPerSample(buffer, [&](juce::AudioBuffer<float>& block)
+        {
+            juce::dsp::AudioBlock<float> audioBlock(block);
+            auto leftBlock = audioBlock.getSingleChannelBlock(0);
+            auto rightBlock = audioBlock.getSingleChannelBlock(1);
+
+            leftChain.process(juce::dsp::ProcessContextReplacing<float>(leftBlock));
+            rightChain.process(juce::dsp::ProcessContextReplacing<float>(rightBlock));
+        });
+    }
+
+    // The same single-pass cascade as MultichannelFilterChain in plain scalar code, one channel after the other
+    double measureScalarChain(const ChainCoefficients& coefficients, int blockSize)
+    {
+        std::vector<BiquadCoefficients> cascade(coefficients.lowCut.begin(), coefficients.lowCut.begin() + coefficients.lowCutSlope + 1);
+        cascade.push_back(coefficients.peak);
+        cascade.insert(cascade.end(), coefficients.highCut.begin(), coefficients.highCut.begin() + coefficients.highCutSlope + 1);
+
+        struct State
+        {
+            float s1{ 0.0f }, s2{ 0.0f };
+        };
+
+        std::vector<std::vector<State>> states(2, std::vector<State>(cascade.size()));
+
+        juce::AudioBuffer<float> buffer(2, blockSize);
+
+        return Benchmark::measureNsPerSample(buffer, [&](juce::AudioBuffer<float>& block)
+        {
+            for (int channel = 0; channel < block.getNumChannels(); ++channel)
+            {
+                auto* samples = block.getWritePointer(channel);
+                auto& channelStates = states[(size_t) channel];
+
+                for (int i = 0; i < block.getNumSamples(); ++i)
+                {
+                    auto sample = samples[i];
+
+                    for (size_t k = 0; k < cascade.size(); ++k)
+                    {
+                        const auto& section = cascade[k];
+                        auto& state = channelStates[k];
+                        auto output = section.b0 * sample + state.s1;
+
+                        state.s1 = section.b1 * sample - section.a1 * output + state.s2;
+                        state.s2 = section.b2 * sample - section.a2 * output;
+                        sample = output;
+                    }
+
+                    samples[i] = sample;
+                }
+            }
+        });
+    }
+
+    double measureStereoChain(const ChainCoefficients& coefficients, int blockSize)
+    {
+        MultichannelFilterChain chain;
+        chain.prepare({ sampleRate, (juce::uint32) blockSize, 2 });
+        chain.setCoefficients(coefficients);
+
+        juce::AudioBuffer<float> buffer(2, blockSize);
+
+        return Benchmark::measureNsPerSample(buffer, [&](juce::AudioBuffer<float>& block)
+        {
+            juce::dsp::AudioBlock<float> audioBlock(block);
+            chain.process(juce::dsp::ProcessContextReplacing<float>(audioBlock));
+        });
+    }
+
+    // With gliding set, every block retargets the cut-offs and the peak, so coefficients are recomputed per sample throughout
+    double measureSvfChain(const ChainCoefficients& coefficients, int blockSize, bool gliding)
+    {
+        SvfFilterChain chain;
+        chain.prepare({ sampleRate, (juce::uint32) blockSize, 2 });
+        chain.setTargets(coefficients);
+
+        auto moved = designChain(coefficients.lowCutSlope, coefficients.highCutSlope, true);
+
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        auto useMoved = false;
+
+        return Benchmark::measureNsPerSample(buffer, [&](juce::AudioBuffer<float>& block)
+        {
+            if (gliding)
+            {
+                useMoved = ! useMoved;
+                chain.setTargets(useMoved ? moved : coefficients);
+            }
+
+            juce::dsp::AudioBlock<float> audioBlock(block);
+            chain.process(juce::dsp::ProcessContextReplacing<float>(audioBlock));
+        });
+    }
+
+    // Biquad chain retargeted every block, so it always runs in control blocks with fresh coefficients
+    double measureControlRate(const ChainCoefficients& coefficients, int blockSize, int controlBlockSize)
+    {
+        MultichannelFilterChain chain;
+        chain.prepare({ sampleRate, (juce::uint32) blockSize, 2 });
+
+        ControlRateSmoother smoother;
+        smoother.prepare(sampleRate, ButterworthTable::getShared(sampleRate));
+        smoother.setControlBlockSize(controlBlockSize);
+
+        auto moved = designChain(coefficients.lowCutSlope, coefficients.highCutSlope, true);
+
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        auto useMoved = false;
+
+        return Benchmark::measureNsPerSample(buffer, [&](juce::AudioBuffer<float>& block)
+        {
+            useMoved = ! useMoved;
+            smoother.setTarget(useMoved ? moved : coefficients);
+            chain.setCoefficients(smoother.getCoefficients());
+
+            juce::dsp::AudioBlock<float> audioBlock(block);
+            smoother.process(chain, juce::dsp::ProcessContextReplacing<float>(audioBlock));
+        });
+    }
+}
+
+void runFilterBenchmarks()
+{
+    std::cout << "=== Stereo filter chain vs. two MonoChains and a scalar cascade (" << sampleRate << " Hz) ===" << std::endl;
+
+    for (auto lowCutSlope : { Slope_12, Slope_24, Slope_36, Slope_48 })
+    {
+        for (auto highCutSlope : { Slope_12, Slope_24, Slope_36, Slope_48 })
+        {
+            auto coefficients = designChain(lowCutSlope, highCutSlope);
+            auto slopeName = juce::String(12 * (lowCutSlope + 1)) + "/" + juce::String(12 * (highCutSlope + 1)) + " dB/Oct";
+
+            // Every IIR::Filter in a MonoChain makes its own pass over its channel
+            auto monoChainPasses = lowCutSlope + 1 + 1 + highCutSlope + 1;
+
+            for (auto blockSize : { 32, 128, 1024 })
+            {
+                Benchmark::printResult("MonoChain x2, " + slopeName, blockSize, measureMonoChains(coefficients, blockSize),
+                                       juce::String(monoChainPasses) + " memory passes");
+                Benchmark::printResult("Scalar cascade x2, " + slopeName, blockSize, measureScalarChain(coefficients, blockSize),
+                                       "1 memory pass");
+                Benchmark::printResult("MultichannelFilterChain, " + slopeName, blockSize, measureStereoChain(coefficients, blockSize),
+                                       juce::String(MultichannelFilterChain::getMemoryPassesPerBlock()) + " memory passes");
+            }
+        }
+    }
+
+    // Default settings: every stage is transparent, so the multichannel chain skips the block entirely
+    ChainSettings neutralSettings;
+    neutralSettings.lowCutFreq = CoefficientDesigner::transparentLowCutFrequency;
+    neutralSettings.highCutFreq = CoefficientDesigner::transparentHighCutFrequency;
+    neutralSettings.peakFreq = 750.0f;
+
+    ChainCoefficients neutralCoefficients;
+    CoefficientDesigner::design(neutralCoefficients, neutralSettings, sampleRate, CoefficientDesigner::allStages);
+
+    for (auto blockSize : { 32, 128, 1024 })
+    {
+        Benchmark::printResult("MonoChain x2, neutral", blockSize, measureMonoChains(neutralCoefficients, blockSize), "3 memory passes");
+        Benchmark::printResult("MultichannelFilterChain, neutral", blockSize, measureStereoChain(neutralCoefficients, blockSize), "skipped");
+    }
+
+    std::cout << std::endl << "=== State-variable engine, settled vs. gliding ===" << std::endl;
+
+    for (auto slope : { Slope_12, Slope_48 })
+    {
+        auto coefficients = designChain(slope, slope);
+        auto slopeName = juce::String(12 * (slope + 1)) + "/" + juce::String(12 * (slope + 1)) + " dB/Oct";
+
+        for (auto blockSize : { 32, 128, 1024 })
+        {
+            Benchmark::printResult("MultichannelFilterChain, " + slopeName, blockSize, measureStereoChain(coefficients, blockSize), "fixed");
+            Benchmark::printResult("SvfFilterChain, " + slopeName, blockSize, measureSvfChain(coefficients, blockSize, false), "settled");
+            Benchmark::printResult("SvfFilterChain, " + slopeName, blockSize, measureSvfChain(coefficients, blockSize, true), "gliding, per-sample coefficients");
+        }
+    }
+
+    // Host block fixed, so only the number of coefficient updates per block changes
+    std::cout << std::endl << "=== Biquad engine gliding, CPU vs. control rate ===" << std::endl;
+
+    constexpr int hostBlockSize = 1024;
+
+    for (auto slope : { Slope_12, Slope_48 })
+    {
+        auto coefficients = designChain(slope, slope);
+        auto slopeName = juce::String(12 * (slope + 1)) + "/" + juce::String(12 * (slope + 1)) + " dB/Oct";
+
+        Benchmark::printResult("MultichannelFilterChain, " + slopeName, hostBlockSize, measureStereoChain(coefficients, hostBlockSize), "settled");
+
+        for (auto controlBlockSize : { 4, 8, 16, 32, 64, 128 })
+            Benchmark::printResult("ControlRateSmoother, " + slopeName, hostBlockSize, measureControlRate(coefficients, hostBlockSize, controlBlockSize),
+                                   juce::String(controlBlockSize) + "-sample control blocks, "
+                                   + juce::String(sampleRate / controlBlockSize, 0) + " updates/s");
+    }
+}
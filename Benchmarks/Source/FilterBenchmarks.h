@@ -0,0 +1,13 @@
+/*
+  ==============================================================================
+
+    FilterBenchmarks.h
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Compares the vectorised MultichannelFilterChain with the previous pair of MonoChains,
+// and the cost of gliding settings in the state-variable engine and at each control rate
+void runFilterBenchmarks();
@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+
+    Entry point of the SimplePlugin benchmark suite.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "FilterBenchmarks.h"
+#include "ReverbBenchmarks.h"
+#include "ProcessorBenchmarks.h"
+#include "ChannelBenchmarks.h"
+#include "StateBenchmarks.h"
+#include "MemoryBenchmarks.h"
+#include "DesignBenchmarks.h"
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ArgumentList arguments(argc, argv);
+
+    // The processor and its parameter state expect a message manager
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    // --suite=filters|reverb|processor|channels|state|memory|design runs a single suite, --json=FILE sets where the processor sweep is written
+    auto suite = arguments.containsOption("--suite") ? arguments.getValueForOption("--suite") : juce::String("all");
+    auto jsonFile = juce::File::getCurrentWorkingDirectory().getChildFile(arguments.containsOption("--json")
+                                                                             ? arguments.getValueForOption("--json")
+                                                                             : juce::String("SimplePluginBenchmarks.json"));
+
+    if (suite == "all" || suite == "filters")
+        runFilterBenchmarks();
+
+    if (suite == "all" || suite == "reverb")
+        runReverbBenchmarks();
+
+    if (suite == "all" || suite == "processor")
+        runProcessorBenchmarks(jsonFile);
+
+    if (suite == "all" || suite == "channels")
+        runChannelBenchmarks();
+
+    if (suite == "all" || suite == "state")
+        runStateBenchmarks();
+
+    if (suite == "all" || suite == "memory")
+        runMemoryBenchmarks();
+
+    // Fails the run if the coefficient tables are less accurate than they promise
+    auto result = 0;
+
+    if (suite == "all" || suite == "design")
+        if (! runDesignBenchmarks())
+            result = 1;
+
+    return result;
+}
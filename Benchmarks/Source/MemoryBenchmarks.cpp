@@ -0,0 +1,80 @@
+/*
+  ==============================================================================
+
+    MemoryBenchmarks.cpp
+
+  ==============================================================================
+*/
+
+#include "MemoryBenchmarks.h"
+#include "../../Source/PluginProcessor.h"
+
+#if JUCE_LINUX
+ #include <malloc.h>
+#endif
+
+namespace
+{
+    constexpr int numInstances = 100;
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 512;
+
+    using Instances = std::vector<std::unique_ptr<SimplePluginAudioProcessor>>;
+
+    // Bytes in use on the heap, including blocks served by mmap; 0 where glibc isn't available
+    size_t getHeapBytes()
+    {
+       #if JUCE_LINUX
+        auto info = mallinfo2();
+        return info.uordblks + info.hblkhd;
+       #else
+        return 0;
+       #endif
+    }
+
+    // Heap growth from creating and preparing count more instances
+    size_t addInstances(Instances& instances, int count)
+    {
+        auto before = getHeapBytes();
+
+        for (int i = 0; i < count; ++i)
+        {
+            instances.push_back(std::make_unique<SimplePluginAudioProcessor>());
+            instances.back()->prepareToPlay(sampleRate, blockSize);
+        }
+
+        return getHeapBytes() - before;
+    }
+
+    juce::String formatKilobytes(double bytes)
+    {
+        return juce::String(bytes / 1024.0, 1).paddedLeft(' ', 9) + " KB";
+    }
+}
+
+void runMemoryBenchmarks()
+{
+    std::cout << "=== Memory, stereo at " << sampleRate << " Hz, block " << blockSize
+              << ", shared resources " << (SIMPLEPLUGIN_SHARED_RESOURCES ? "on" : "off") << " ===" << std::endl;
+
+    if (getHeapBytes() == 0)
+    {
+        std::cout << "Heap statistics are only available with glibc" << std::endl;
+        return;
+    }
+
+    Instances instances;
+
+    // The first instance also creates everything the others share
+    auto firstBytes = addInstances(instances, 1);
+    auto furtherBytes = addInstances(instances, numInstances - 1);
+    auto usage = SharedResources::getUsage();
+
+    std::cout << juce::String("First instance").paddedRight(' ', 40) << formatKilobytes((double) firstBytes) << std::endl;
+    std::cout << juce::String("Each further instance").paddedRight(' ', 40)
+              << formatKilobytes((double) furtherBytes / (numInstances - 1)) << std::endl;
+    std::cout << juce::String("Shared, once per process").paddedRight(' ', 40) << formatKilobytes((double) usage.numBytes)
+              << " in " << usage.numResources << " resources" << std::endl;
+    std::cout << juce::String(numInstances).paddedLeft(' ', 3) << juce::String(" instances").paddedRight(' ', 37)
+              << formatKilobytes((double) (firstBytes + furtherBytes)) << std::endl;
+}
@@ -0,0 +1,13 @@
+/*
+  ==============================================================================
+
+    MemoryBenchmarks.h
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Heap footprint of a prepared instance, with the shared read-only resources reported separately.
+// Build with SIMPLEPLUGIN_SHARED_RESOURCES=0 for the footprint without sharing.
+void runMemoryBenchmarks();
@@ -0,0 +1,247 @@
+/*
+  ==============================================================================
+
+    ProcessorBenchmarks.cpp
+
+  ==============================================================================
+*/
+
+#include "ProcessorBenchmarks.h"
+#include "BenchmarkUtilities.h"
+#include "../../Source/PluginProcessor.h"
+
+namespace
+{
+    constexpr std::array<int, 9> blockSizes{ 16, 32, 64, 128, 256, 512, 1024, 2048, 4096 };
+    constexpr std::array<double, 5> sampleRates{ 44100.0, 48000.0, 88200.0, 96000.0, 192000.0 };
+
+    // Automated runs change their parameters before every block, alternating between two values
+    enum class Automation
+    {
+        none,
+        everyBlock
+    };
+
+    const char* getAutomationName(Automation automation)
+    {
+        return automation == Automation::none ? "static" : "automated";
+    }
+
+    class ResultCollector
+    {
+    public:
+        void add(const juce::String& stage, const juce::String& variant, double sampleRate, int blockSize, Automation automation, double nsPerSample)
+        {
+            auto* result = new juce::DynamicObject();
+            result->setProperty("stage", stage);
+            result->setProperty("variant", variant);
+            result->setProperty("sampleRate", sampleRate);
+            result->setProperty("blockSize", blockSize);
+            result->setProperty("automation", getAutomationName(automation));
+            result->setProperty("nsPerSample", nsPerSample);
+            results.add(juce::var(result));
+
+            Benchmark::printResult(stage + " " + variant + " @ " + juce::String(sampleRate / 1000.0, 1) + " kHz",
+                                   blockSize, nsPerSample, getAutomationName(automation));
+        }
+
+        bool write(const juce::File& file) const
+        {
+            auto* root = new juce::DynamicObject();
+            root->setProperty("suite", "processor");
+            root->setProperty("date", juce::Time::getCurrentTime().toISO8601(true));
+            root->setProperty("juceVersion", juce::SystemStats::getJUCEVersion());
+            root->setProperty("cpu", juce::SystemStats::getCpuModel());
+            root->setProperty("numCpus", juce::SystemStats::getNumCpus());
+           #if JUCE_DEBUG
+            root->setProperty("build", "Debug");
+           #else
+            root->setProperty("build", "Release");
+           #endif
+            root->setProperty("samplesPerMeasurement", Benchmark::samplesPerMeasurement);
+            root->setProperty("results", results);
+
+            return file.replaceWithText(juce::JSON::toString(juce::var(root)));
+        }
+
+    private:
+        juce::Array<juce::var> results;
+    };
+
+    //==============================================================================
+    ChainSettings getChainSettings(Slope slope, bool alternate)
+    {
+        ChainSettings settings;
+        settings.lowCutFreq = alternate ? 100.0f : 80.0f;
+        settings.highCutFreq = alternate ? 10000.0f : 12000.0f;
+        settings.peakFreq = alternate ? 1500.0f : 750.0f;
+        settings.peakGainInDecibels = alternate ? -3.0f : 6.0f;
+        settings.lowCutSlope = slope;
+        settings.highCutSlope = slope;
+        return settings;
+    }
+
+    double measureProcessBlock(double sampleRate, int blockSize, ReverbEngine engine, Automation automation)
+    {
+        SimplePluginAudioProcessor processor;
+
+        auto setParameter = [&processor](const char* parameterID, float value)
+        {
+            auto* parameter = processor.apvts.getParameter(parameterID);
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+        };
+
+        setParameter(ParameterIDs::reverbEngine, (float) engine);
+
+        processor.setPlayConfigDetails(2, 2, sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        juce::MidiBuffer midiMessages;
+        int blockIndex = 0;
+
+        auto nsPerSample = Benchmark::measureNsPerSample(buffer, [&](juce::AudioBuffer<float>& block)
+        {
+            // Host automation: the listener marks stages dirty and the designer thread picks them up
+            if (automation == Automation::everyBlock)
+            {
+                auto alternate = (++blockIndex & 1) != 0;
+                setParameter(ParameterIDs::lowCutFreq, alternate ? 100.0f : 80.0f);
+                setParameter(ParameterIDs::peakFreq, alternate ? 1500.0f : 750.0f);
+                setParameter(ParameterIDs::mix, alternate ? 0.4f : 0.5f);
+            }
+
+            processor.processBlock(block, midiMessages);
+        });
+
+        processor.releaseResources();
+        return nsPerSample;
+    }
+
+    double measureFilterChain(double sampleRate, int blockSize, Slope slope, Automation automation)
+    {
+        std::array<ChainCoefficients, 2> coefficients;
+        CoefficientDesigner::design(coefficients[0], getChainSettings(slope, false), sampleRate, CoefficientDesigner::allStages);
+        CoefficientDesigner::design(coefficients[1], getChainSettings(slope, true), sampleRate, CoefficientDesigner::allStages);
+
+        MultichannelFilterChain chain;
+        chain.prepare({ sampleRate, (juce::uint32) blockSize, 2 });
+        chain.setCoefficients(coefficients[0]);
+
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        int blockIndex = 0;
+
+        return Benchmark::measureNsPerSample(buffer, [&](juce::AudioBuffer<float>& block)
+        {
+            if (automation == Automation::everyBlock)
+                chain.setCoefficients(coefficients[(size_t) (++blockIndex & 1)]);
+
+            juce::dsp::AudioBlock<float> audioBlock(block);
+            chain.process(juce::dsp::ProcessContextReplacing<float>(audioBlock));
+        });
+    }
+
+    double measureFreeverb(double sampleRate, int blockSize, Automation automation)
+    {
+        juce::dsp::Reverb reverb;
+        reverb.prepare({ sampleRate, (juce::uint32) blockSize, 2 });
+
+        std::array<juce::dsp::Reverb::Parameters, 2> parameters;
+        parameters[0].roomSize = 0.5f;
+        parameters[1].roomSize = 0.6f;
+
+        for (auto& p : parameters)
+        {
+            p.wetLevel = 0.5f;
+            p.dryLevel = 0.0f;
+        }
+
+        reverb.setParameters(parameters[0]);
+
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        int blockIndex = 0;
+
+        return Benchmark::measureNsPerSample(buffer, [&](juce::AudioBuffer<float>& block)
+        {
+            if (automation == Automation::everyBlock)
+                reverb.setParameters(parameters[(size_t) (++blockIndex & 1)]);
+
+            juce::dsp::AudioBlock<float> audioBlock(block);
+            reverb.process(juce::dsp::ProcessContextReplacing<float>(audioBlock));
+        });
+    }
+
+    double measureFeedbackDelayNetwork(double sampleRate, int blockSize, Automation automation)
+    {
+        CustomReverb reverb;
+        reverb.setParameters(0.5f, 0.5f, 0.5f, 0.0f);
+        reverb.prepare({ sampleRate, (juce::uint32) blockSize, 2 });
+
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        int blockIndex = 0;
+
+        return Benchmark::measureNsPerSample(buffer, [&](juce::AudioBuffer<float>& block)
+        {
+            if (automation == Automation::everyBlock)
+                reverb.setParameters((++blockIndex & 1) != 0 ? 0.6f : 0.5f, 0.5f, 0.5f, 0.0f);
+
+            juce::dsp::AudioBlock<float> audioBlock(block);
+            reverb.process(juce::dsp::ProcessContextReplacing<float>(audioBlock));
+        });
+    }
+
+    double measurePreDelay(double sampleRate, int blockSize, Automation automation)
+    {
+        PreDelay preDelay;
+        preDelay.prepare({ sampleRate, (juce::uint32) blockSize, 2 });
+        preDelay.setDelay(0.02f);
+        preDelay.reset();
+
+        juce::AudioBuffer<float> buffer(2, blockSize), wetBuffer(2, blockSize);
+        juce::dsp::AudioBlock<float> wetBlock(wetBuffer);
+        int blockIndex = 0;
+
+        return Benchmark::measureNsPerSample(buffer, [&](juce::AudioBuffer<float>& block)
+        {
+            if (automation == Automation::everyBlock)
+                preDelay.setDelay((++blockIndex & 1) != 0 ? 0.025f : 0.02f);
+
+            preDelay.process(juce::dsp::AudioBlock<float>(block), wetBlock);
+        });
+    }
+}
+
+void runProcessorBenchmarks(const juce::File& jsonFile)
+{
+    std::cout << "=== processBlock and stages across block sizes and sample rates ===" << std::endl;
+
+    ResultCollector results;
+
+    for (auto sampleRate : sampleRates)
+    {
+        for (auto blockSize : blockSizes)
+        {
+            for (auto automation : { Automation::none, Automation::everyBlock })
+            {
+                results.add("processBlock", "Freeverb", sampleRate, blockSize, automation,
+                            measureProcessBlock(sampleRate, blockSize, ReverbEngine::Freeverb, automation));
+                results.add("processBlock", "FDN", sampleRate, blockSize, automation,
+                            measureProcessBlock(sampleRate, blockSize, ReverbEngine::FeedbackDelayNetwork, automation));
+
+                // Low cut, peak and high cut run fused in one pass, so the EQ is measured per slope as a whole
+                for (auto slope : { Slope_12, Slope_24, Slope_36, Slope_48 })
+                    results.add("eq", juce::String(12 * (slope + 1)) + " dB/Oct", sampleRate, blockSize, automation,
+                                measureFilterChain(sampleRate, blockSize, slope, automation));
+
+                results.add("preDelay", "20 ms", sampleRate, blockSize, automation, measurePreDelay(sampleRate, blockSize, automation));
+                results.add("reverb", "Freeverb", sampleRate, blockSize, automation, measureFreeverb(sampleRate, blockSize, automation));
+                results.add("reverb", "FDN", sampleRate, blockSize, automation, measureFeedbackDelayNetwork(sampleRate, blockSize, automation));
+            }
+        }
+    }
+
+    if (results.write(jsonFile))
+        std::cout << "Results written to " << jsonFile.getFullPathName() << std::endl;
+    else
+        std::cerr << "Can't write " << jsonFile.getFullPathName() << std::endl;
+}
@@ -0,0 +1,15 @@
+/*
+  ==============================================================================
+
+    ProcessorBenchmarks.h
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Sweeps processBlock and every stage on its own over block sizes, sample rates and
+// static vs. per-block automated parameters, and writes all results to jsonFile
+void runProcessorBenchmarks(const juce::File& jsonFile);
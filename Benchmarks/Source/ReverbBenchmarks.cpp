@@ -0,0 +1,146 @@
+/*
+  ==============================================================================
+
+    ReverbBenchmarks.cpp
+
+  ==============================================================================
+*/
+
+#include "ReverbBenchmarks.h"
+#include "BenchmarkUtilities.h"
+#include "../../Source/CustomReverb.h"
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr float roomSize = 0.5f;
+    constexpr float damping = 0.5f;
+
+    struct FreeverbEngine
+    {
+        juce::dsp::Reverb reverb;
+
+        void prepare(const juce::dsp::ProcessSpec& spec)
+        {
+            reverb.prepare(spec);
+
+            juce::dsp::Reverb::Parameters parameters;
+            parameters.roomSize = roomSize;
+            parameters.damping = damping;
+            parameters.wetLevel = 1.0f;
+            parameters.dryLevel = 0.0f;
+            reverb.setParameters(parameters);
+        }
+
+        void process(const juce::dsp::ProcessContextReplacing<float>& context) { reverb.process(context); }
+    };
+
+    struct FeedbackDelayNetworkEngine
+    {
+        CustomReverb reverb;
+
+        void prepare(const juce::dsp::ProcessSpec& spec)
+        {
+            reverb.setParameters(roomSize, damping, 1.0f, 0.0f);
+            reverb.prepare(spec);
+        }
+
+        void process(const juce::dsp::ProcessContextReplacing<float>& context) { reverb.process(context); }
+    };
+
+    template <typename Engine>
+    double measureEngine(int blockSize)
+    {
+        Engine engine;
+        engine.prepare({ sampleRate, (juce::uint32) blockSize, 2 });
+
+        juce::AudioBuffer<float> buffer(2, blockSize);
+
+        return Benchmark::measureNsPerSample(buffer, [&](juce::AudioBuffer<float>& block)
+        {
+            juce::dsp::AudioBlock<float> audioBlock(block);
+            engine.process(juce::dsp::ProcessContextReplacing<float>(audioBlock));
+        });
+    }
+
+    // Normalised echo density (Abel & Huang) of a 20 ms window around timeInSeconds:
+    // the fraction of samples above one standard deviation, relative to a Gaussian tail.
+    // It approaches 1 once the tail is as dense as noise.
+    double getEchoDensity(const std::vector<float>& impulseResponse, double timeInSeconds)
+    {
+        auto windowSize = (int) (0.02 * sampleRate);
+        auto start = juce::jlimit(0, (int) impulseResponse.size() - windowSize, (int) (timeInSeconds * sampleRate) - windowSize / 2);
+
+        double energy = 0.0;
+
+        for (int i = start; i < start + windowSize; ++i)
+            energy += impulseResponse[(size_t) i] * impulseResponse[(size_t) i];
+
+        auto standardDeviation = std::sqrt(energy / windowSize);
+        int numAbove = 0;
+
+        for (int i = start; i < start + windowSize; ++i)
+            if (std::abs(impulseResponse[(size_t) i]) > standardDeviation)
+                ++numAbove;
+
+        constexpr double gaussianFractionAbove = 0.3173;
+        return numAbove / (double) windowSize / gaussianFractionAbove;
+    }
+
+    template <typename Engine>
+    std::vector<float> renderImpulseResponse(double lengthInSeconds)
+    {
+        constexpr int blockSize = 512;
+
+        Engine engine;
+        engine.prepare({ sampleRate, (juce::uint32) blockSize, 2 });
+
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        std::vector<float> impulseResponse;
+
+        for (int rendered = 0; rendered < (int) (lengthInSeconds * sampleRate); rendered += blockSize)
+        {
+            buffer.clear();
+
+            if (rendered == 0)
+            {
+                buffer.setSample(0, 0, 1.0f);
+                buffer.setSample(1, 0, 1.0f);
+            }
+
+            juce::dsp::AudioBlock<float> audioBlock(buffer);
+            engine.process(juce::dsp::ProcessContextReplacing<float>(audioBlock));
+
+            impulseResponse.insert(impulseResponse.end(), buffer.getReadPointer(0), buffer.getReadPointer(0) + blockSize);
+        }
+
+        return impulseResponse;
+    }
+
+    template <typename Engine>
+    void printEchoDensity(const juce::String& name)
+    {
+        auto impulseResponse = renderImpulseResponse<Engine>(0.5);
+
+        std::cout << name.paddedRight(' ', 40) << " echo density";
+
+        for (auto time : { 0.05, 0.1, 0.2, 0.4 })
+            std::cout << "  " << juce::roundToInt(time * 1000.0) << " ms: " << juce::String(getEchoDensity(impulseResponse, time), 2);
+
+        std::cout << std::endl;
+    }
+}
+
+void runReverbBenchmarks()
+{
+    std::cout << "=== juce::dsp::Reverb vs. CustomReverb (" << sampleRate << " Hz) ===" << std::endl;
+
+    for (auto blockSize : { 32, 128, 1024 })
+    {
+        Benchmark::printResult("Freeverb", blockSize, measureEngine<FreeverbEngine>(blockSize));
+        Benchmark::printResult("CustomReverb (8 line FDN)", blockSize, measureEngine<FeedbackDelayNetworkEngine>(blockSize));
+    }
+
+    printEchoDensity<FreeverbEngine>("Freeverb");
+    printEchoDensity<FeedbackDelayNetworkEngine>("CustomReverb (8 line FDN)");
+}
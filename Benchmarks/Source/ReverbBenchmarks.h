@@ -0,0 +1,12 @@
+/*
+  ==============================================================================
+
+    ReverbBenchmarks.h
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Compares CustomReverb with juce::dsp::Reverb for cost and echo density
+void runReverbBenchmarks();
@@ -0,0 +1,80 @@
+/*
+  ==============================================================================
+
+    StateBenchmarks.cpp
+
+  ==============================================================================
+*/
+
+#include "StateBenchmarks.h"
+#include "BenchmarkUtilities.h"
+#include "../../Source/PluginProcessor.h"
+
+namespace
+{
+    constexpr int numInstances = 500;
+
+    using Instances = std::vector<std::unique_ptr<SimplePluginAudioProcessor>>;
+
+    // A session where every parameter is away from its default
+    void configure(SimplePluginAudioProcessor& processor)
+    {
+        for (auto* parameterID : ParameterIDs::all)
+        {
+            auto* parameter = processor.apvts.getParameter(parameterID);
+            parameter->setValueNotifyingHost(1.0f - parameter->getDefaultValue() * 0.5f);
+        }
+    }
+
+    template <typename RestoreFunction>
+    double measureRestoreMs(Instances& instances, RestoreFunction&& restore)
+    {
+        auto start = juce::Time::getHighResolutionTicks();
+
+        for (auto& instance : instances)
+            restore(*instance);
+
+        return juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start) * 1000.0;
+    }
+
+    void printRestore(const juce::String& name, double milliseconds, size_t stateSize)
+    {
+        std::cout << name.paddedRight(' ', 40) << juce::String(milliseconds, 2).paddedLeft(' ', 9) << " ms for "
+                  << numInstances << " instances  " << juce::String(milliseconds * 1000.0 / numInstances, 2) << " us each  "
+                  << (int) stateSize << " bytes" << std::endl;
+    }
+}
+
+void runStateBenchmarks()
+{
+    std::cout << "=== Session restore, " << numInstances << " instances ===" << std::endl;
+
+    SimplePluginAudioProcessor source;
+    configure(source);
+
+    juce::MemoryBlock binaryState;
+    source.getStateInformation(binaryState);
+
+    // The usual approach this format replaces
+    juce::MemoryBlock xmlState;
+    juce::AudioProcessor::copyXmlToBinary(*source.apvts.copyState().createXml(), xmlState);
+
+    Instances instances;
+
+    for (int i = 0; i < numInstances; ++i)
+        instances.push_back(std::make_unique<SimplePluginAudioProcessor>());
+
+    auto binaryMs = measureRestoreMs(instances, [&](SimplePluginAudioProcessor& processor)
+    {
+        processor.setStateInformation(binaryState.getData(), (int) binaryState.getSize());
+    });
+
+    auto xmlMs = measureRestoreMs(instances, [&](SimplePluginAudioProcessor& processor)
+    {
+        if (auto xml = juce::AudioProcessor::getXmlFromBinary(xmlState.getData(), (int) xmlState.getSize()))
+            processor.apvts.replaceState(juce::ValueTree::fromXml(*xml));
+    });
+
+    printRestore("Binary state", binaryMs, binaryState.getSize());
+    printRestore("APVTS ValueTree as XML", xmlMs, xmlState.getSize());
+}
@@ -0,0 +1,12 @@
+/*
+  ==============================================================================
+
+    StateBenchmarks.h
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Time to restore a session of many instances from the binary state, against the APVTS ValueTree as XML
+void runStateBenchmarks();
@@ -1,26 +0,0 @@
-#include "CustomReverb.h"
-
-CustomReverb::CustomReverb()
-{
-    // Hier knnen Sie die Initialisierung Ihres benutzerdefinierten Reverbs durchfhren
-}
-
-CustomReverb::~CustomReverb()
-{
-    // Hier knnen Sie Ressourcen freigeben, die von Ihrem benutzerdefinierten Reverb verwendet werden
-}
-
-void CustomReverb::prepare(const juce::dsp::ProcessSpec& spec)
-{
-    // Hier knnen Sie Ihren Reverb auf Basis der bereitgestellten ProcessSpec initialisieren
-}
-
-void CustomReverb::setParameters(float roomSize, float damping, float wetLevel, float dryLevel)
-{
-    // Hier knnen Sie die Parameter Ihres Reverbs aktualisieren
-}
-
-void CustomReverb::process(juce::AudioBuffer<float>& buffer)
-{
-    // Hier knnen Sie den Reverb-Effekt auf das bereitgestellte AudioBuffer anwenden
-}
\ No newline at end of file
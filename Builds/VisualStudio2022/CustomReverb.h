@@ -1,20 +0,0 @@
-#pragma once
-
-#include <JuceHeader.h>
-
-
-class CustomReverb
-{
-public:
-    CustomReverb();
-    ~CustomReverb();
-
-    void prepare(const juce::dsp::ProcessSpec& spec);
-    void setParameters(float roomSize, float damping, float wetLevel, float dryLevel);
-    void process(juce::AudioBuffer<float>& buffer);
-
-private:
-    // Hier knnen Sie private Attribute und Methoden fr Ihren benutzerdefinierten Reverb implementieren
-
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CustomReverb)
-};
\ No newline at end of file
@@ -0,0 +1,148 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+
+    Command line renderer: runs WAV/FLAC files through SimplePlugin offline.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "OfflineRenderer.h"
+#include "ScalingBenchmark.h"
+
+namespace
+{
+    void printUsage()
+    {
+        std::cout << "Usage: SimplePluginRender <input> <output> [options] [\"Parameter ID=value\" ...]" << std::endl
+                  << "       SimplePluginRender --scaling [--streams=N] [--seconds=SECONDS] [--block-size=N]" << std::endl
+                  << std::endl
+                  << "  --block-size=N       samples per processBlock call (default 4096)" << std::endl
+                  << "  --bits=N             output bit depth (default 24)" << std::endl
+                  << "  --state=FILE         parameter tree (XML) or saved plugin state applied first" << std::endl
+                  << "  --tail=SECONDS       reverb tail rendered after the input (default: the processor's tail length)" << std::endl
+                  << "  --list-parameters    print the parameter IDs and exit" << std::endl
+                  << "  --realtime-abort     abort on the first allocation or lock inside processBlock (debug builds on Linux)" << std::endl
+                  << "  --scaling            render N streams of noise on 1 up to all cores and print the throughput" << std::endl
+                  << "  --streams=N          number of independent processor instances for --scaling (default 128)" << std::endl
+                  << "  --seconds=SECONDS    audio per stream for --scaling (default 10)" << std::endl
+                  << std::endl
+                  << "Values are plain numbers (choice index, Hz, dB, ...) or the parameter's text, e.g. \"Reverb Engine=FDN\"." << std::endl;
+    }
+
+    void printParameters()
+    {
+        SimplePluginAudioProcessor processor;
+
+        for (auto* parameterID : ParameterIDs::all)
+        {
+            auto* parameter = processor.apvts.getParameter(parameterID);
+            std::cout << juce::String(parameterID).paddedRight(' ', 16) << " default "
+                      << parameter->getCurrentValueAsText() << std::endl;
+        }
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ArgumentList arguments(argc, argv);
+
+    // Creates the message manager the parameter state expects, but no message loop is ever run
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    if (arguments.containsOption("--list-parameters"))
+    {
+        printParameters();
+        return 0;
+    }
+
+    RenderSettings settings;
+    juce::StringArray files;
+
+    auto scaling = false;
+    auto numStreams = 128;
+    auto secondsPerStream = 10.0;
+
+    for (auto& argument : arguments.arguments)
+    {
+        if (argument.isLongOption("block-size"))
+            settings.blockSize = argument.getLongOptionValue().getIntValue();
+        else if (argument.isLongOption("bits"))
+            settings.bitsPerSample = argument.getLongOptionValue().getIntValue();
+        else if (argument.isLongOption("state"))
+            settings.stateFile = juce::File::getCurrentWorkingDirectory().getChildFile(argument.getLongOptionValue());
+        else if (argument.isLongOption("tail"))
+            settings.tailSeconds = argument.getLongOptionValue().getDoubleValue();
+        else if (argument.isLongOption("realtime-abort"))
+            RealtimeSafety::setFailureMode(RealtimeSafety::FailureMode::abort);
+        else if (argument.isLongOption("scaling"))
+            scaling = true;
+        else if (argument.isLongOption("streams"))
+            numStreams = argument.getLongOptionValue().getIntValue();
+        else if (argument.isLongOption("seconds"))
+            secondsPerStream = argument.getLongOptionValue().getDoubleValue();
+        else if (argument.isOption())
+        {
+            std::cerr << "Unknown option " << argument.text << std::endl;
+            return 1;
+        }
+        else if (argument.text.contains("="))
+            settings.parameterValues.set(argument.text.upToFirstOccurrenceOf("=", false, false).trim(),
+                                         argument.text.fromFirstOccurrenceOf("=", false, false));
+        else
+            files.add(argument.text);
+    }
+
+    if (scaling)
+    {
+        if (numStreams <= 0 || settings.blockSize <= 0)
+        {
+            printUsage();
+            return 1;
+        }
+
+        runScalingBenchmark(numStreams, secondsPerStream, settings.blockSize);
+        return 0;
+    }
+
+    if (files.size() != 2)
+    {
+        printUsage();
+        return 1;
+    }
+
+    settings.inputFile = juce::File::getCurrentWorkingDirectory().getChildFile(files[0]);
+    settings.outputFile = juce::File::getCurrentWorkingDirectory().getChildFile(files[1]);
+
+    OfflineRenderer renderer;
+    RenderStatistics statistics;
+
+    auto result = renderer.render(settings, statistics);
+
+    if (result.failed())
+    {
+        std::cerr << result.getErrorMessage() << std::endl;
+        return 1;
+    }
+
+    std::cout << "Rendered " << juce::String(statistics.getAudioSeconds(), 2) << " s of audio in "
+              << juce::String(statistics.wallSeconds, 3) << " s" << std::endl
+              << "Real-time factor " << juce::String(statistics.getRealTimeFactor(), 1) << "x (processBlock only "
+              << juce::String(statistics.getProcessRealTimeFactor(), 1) << "x)" << std::endl;
+
+    if (RealtimeSafety::isEnabled)
+    {
+        auto violations = RealtimeSafety::getViolationCount();
+
+        std::cout << "Real-time violations: " << violations.allocations << " allocations, " << violations.deallocations
+                  << " frees, " << violations.mutexLocks << " mutex locks" << std::endl;
+
+        if (violations.getTotal() > 0)
+            return 2;
+    }
+
+    return 0;
+}
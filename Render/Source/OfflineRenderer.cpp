@@ -0,0 +1,194 @@
+/*
+  ==============================================================================
+
+    OfflineRenderer.cpp
+
+  ==============================================================================
+*/
+
+#include "OfflineRenderer.h"
+
+OfflineRenderer::OfflineRenderer()
+{
+    formatManager.registerBasicFormats();
+    ioThread.startThread();
+}
+
+OfflineRenderer::~OfflineRenderer()
+{
+    ioThread.stopThread(1000);
+}
+
+//==============================================================================
+juce::Result OfflineRenderer::render(const RenderSettings& settings, RenderStatistics& statistics)
+{
+    auto wallStart = juce::Time::getHighResolutionTicks();
+    auto blockSize = settings.blockSize;
+
+    if (blockSize <= 0)
+        return juce::Result::fail("The block size has to be positive");
+
+    //Input
+    std::unique_ptr<juce::AudioFormatReader> fileReader(formatManager.createReaderFor(settings.inputFile));
+
+    if (fileReader == nullptr)
+        return juce::Result::fail("Can't read " + settings.inputFile.getFullPathName());
+
+    auto sampleRate = fileReader->sampleRate;
+    auto numChannels = (int) fileReader->numChannels;
+    auto lengthInSamples = fileReader->lengthInSamples;
+
+    // Decodes on the I/O thread ahead of the render position; reads wait instead of returning silence
+    juce::BufferingAudioReader reader(fileReader.release(), ioThread, readAheadBlocks * blockSize);
+    reader.setReadTimeout(-1);
+
+    //Output
+    auto* format = formatManager.findFormatForFileExtension(settings.outputFile.getFileExtension());
+
+    if (format == nullptr)
+        return juce::Result::fail("Unknown output format " + settings.outputFile.getFileExtension());
+
+    settings.outputFile.deleteFile();
+    auto outputStream = std::make_unique<juce::FileOutputStream>(settings.outputFile);
+
+    if (outputStream->failedToOpen())
+        return juce::Result::fail("Can't write " + settings.outputFile.getFullPathName());
+
+    std::unique_ptr<juce::AudioFormatWriter> fileWriter(format->createWriterFor(outputStream.get(), sampleRate, (unsigned int) numChannels,
+                                                                                settings.bitsPerSample, {}, 0));
+
+    if (fileWriter == nullptr)
+        return juce::Result::fail(format->getFormatName() + " can't write " + juce::String(settings.bitsPerSample) + " bit at "
+                                  + juce::String(sampleRate) + " Hz");
+
+    // The writer owns the stream from here on
+    outputStream.release();
+
+    //Processor
+    SimplePluginAudioProcessor processor;
+
+    auto result = applySettings(processor, settings);
+
+    if (result.failed())
+        return result;
+
+    processor.setNonRealtime(true);
+    // The file's channels map straight onto the processor's buses, so surround and ambisonic files render as they are
+    processor.setPlayConfigDetails(numChannels, numChannels, sampleRate, blockSize);
+    processor.prepareToPlay(sampleRate, blockSize);
+
+    // The first latency samples are dropped and the same amount is rendered past the end, so the output lines up with the input
+    auto samplesToSkip = (juce::int64) processor.getLatencySamples();
+    auto tailSeconds = settings.tailSeconds < 0.0 ? processor.getTailLengthSeconds() : settings.tailSeconds;
+    auto outputLength = lengthInSamples + (juce::int64) std::ceil(tailSeconds * sampleRate);
+
+    juce::AudioBuffer<float> buffer(numChannels, blockSize);
+    std::vector<const float*> channels((size_t) numChannels);
+    juce::MidiBuffer midiMessages;
+
+    juce::int64 readPosition = 0;
+    juce::int64 written = 0;
+    juce::int64 processTicks = 0;
+
+    {
+        juce::AudioFormatWriter::ThreadedWriter writer(fileWriter.release(), ioThread, writeBehindBlocks * blockSize);
+
+        while (written < outputLength)
+        {
+            // Past the end of the file the reader fills the buffer with silence, which renders the tail
+            reader.read(&buffer, 0, blockSize, readPosition, true, true);
+            readPosition += blockSize;
+
+            auto processStart = juce::Time::getHighResolutionTicks();
+            processor.processBlock(buffer, midiMessages);
+            processTicks += juce::Time::getHighResolutionTicks() - processStart;
+
+            auto skip = (int) juce::jmin((juce::int64) blockSize, samplesToSkip);
+            samplesToSkip -= skip;
+
+            auto numToWrite = (int) juce::jmin((juce::int64) (blockSize - skip), outputLength - written);
+
+            if (numToWrite <= 0)
+                continue;
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                channels[(size_t) channel] = buffer.getReadPointer(channel, skip);
+
+            // Only fails while the FIFO is full, i.e. when the encoder is slower than the render loop
+            while (! writer.write(channels.data(), numToWrite))
+                juce::Thread::sleep(1);
+
+            written += numToWrite;
+        }
+
+        // The writer flushes the rest of its FIFO when it goes out of scope
+    }
+
+    processor.releaseResources();
+
+    statistics.samplesRendered = written;
+    statistics.sampleRate = sampleRate;
+    statistics.processSeconds = juce::Time::highResolutionTicksToSeconds(processTicks);
+    statistics.wallSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - wallStart);
+
+    return juce::Result::ok();
+}
+
+//==============================================================================
+juce::Result OfflineRenderer::applySettings(SimplePluginAudioProcessor& processor, const RenderSettings& settings)
+{
+    if (settings.stateFile != juce::File())
+    {
+        auto result = applyStateFile(processor, settings.stateFile);
+
+        if (result.failed())
+            return result;
+    }
+
+    return applyParameterValues(processor, settings.parameterValues);
+}
+
+juce::Result OfflineRenderer::applyStateFile(SimplePluginAudioProcessor& processor, const juce::File& stateFile)
+{
+    juce::MemoryBlock data;
+
+    if (! stateFile.loadFileAsData(data))
+        return juce::Result::fail("Can't read " + stateFile.getFullPathName());
+
+    // A parameter tree saved as XML is applied directly, anything else is handed to the processor as a saved state
+    if (auto xml = juce::parseXML(data.toString()))
+    {
+        auto state = juce::ValueTree::fromXml(*xml);
+
+        if (state.hasType(processor.apvts.state.getType()))
+        {
+            processor.apvts.replaceState(state);
+            return juce::Result::ok();
+        }
+    }
+
+    processor.setStateInformation(data.getData(), (int) data.getSize());
+    return juce::Result::ok();
+}
+
+juce::Result OfflineRenderer::applyParameterValues(SimplePluginAudioProcessor& processor, const juce::StringPairArray& parameterValues)
+{
+    for (auto& parameterID : parameterValues.getAllKeys())
+    {
+        auto* parameter = processor.apvts.getParameter(parameterID);
+
+        if (parameter == nullptr)
+            return juce::Result::fail("Unknown parameter \"" + parameterID + "\"");
+
+        auto text = parameterValues[parameterID].trim();
+        auto isNumber = text.isNotEmpty() && text.containsOnly("0123456789.-+eE");
+
+        // Numbers are plain values (choice index, Hz, dB, ...), anything else goes through the parameter's text conversion
+        auto normalisedValue = isNumber ? parameter->convertTo0to1(text.getFloatValue())
+                                        : parameter->getValueForText(text);
+
+        parameter->setValueNotifyingHost(juce::jlimit(0.0f, 1.0f, normalisedValue));
+    }
+
+    return juce::Result::ok();
+}
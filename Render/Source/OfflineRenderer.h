@@ -0,0 +1,74 @@
+/*
+  ==============================================================================
+
+    OfflineRenderer.h
+
+    Streams an audio file through a headless SimplePluginAudioProcessor as
+    fast as the machine allows. Decoding runs ahead and encoding runs behind
+    on a shared I/O thread, so the render loop only waits on processBlock.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../Source/PluginProcessor.h"
+
+struct RenderSettings
+{
+    juce::File inputFile, outputFile;
+
+    // Optional parameter tree (XML) or a blob from getStateInformation, applied before the parameter values
+    juce::File stateFile;
+
+    // Parameter ID -> value, as a plain number or as the parameter's text (e.g. "FDN")
+    juce::StringPairArray parameterValues;
+
+    int blockSize{ 4096 };
+    int bitsPerSample{ 24 };
+
+    // Seconds of reverb tail rendered after the input ends; negative uses getTailLengthSeconds()
+    double tailSeconds{ -1.0 };
+};
+
+struct RenderStatistics
+{
+    juce::int64 samplesRendered{ 0 };
+    double sampleRate{ 0.0 };
+    double wallSeconds{ 0.0 };
+    double processSeconds{ 0.0 };
+
+    double getAudioSeconds() const { return sampleRate > 0.0 ? (double) samplesRendered / sampleRate : 0.0; }
+
+    // Seconds of audio rendered per second of wall clock time, including decoding and encoding
+    double getRealTimeFactor() const { return wallSeconds > 0.0 ? getAudioSeconds() / wallSeconds : 0.0; }
+
+    // The same, counting only the time spent inside processBlock
+    double getProcessRealTimeFactor() const { return processSeconds > 0.0 ? getAudioSeconds() / processSeconds : 0.0; }
+};
+
+class OfflineRenderer
+{
+public:
+    OfflineRenderer();
+    ~OfflineRenderer();
+
+    juce::Result render(const RenderSettings& settings, RenderStatistics& statistics);
+
+    // Applies the state file and the parameter values of settings to processor
+    static juce::Result applySettings(SimplePluginAudioProcessor& processor, const RenderSettings& settings);
+
+private:
+    static juce::Result applyStateFile(SimplePluginAudioProcessor& processor, const juce::File& stateFile);
+    static juce::Result applyParameterValues(SimplePluginAudioProcessor& processor, const juce::StringPairArray& parameterValues);
+
+    // How many blocks the reader decodes ahead and the writer may lag behind
+    static constexpr int readAheadBlocks = 8;
+    static constexpr int writeBehindBlocks = 8;
+
+    juce::AudioFormatManager formatManager;
+    juce::TimeSliceThread ioThread{ "Render I/O" };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OfflineRenderer)
+};
@@ -0,0 +1,203 @@
+/*
+  ==============================================================================
+
+    RenderServer.cpp
+
+  ==============================================================================
+*/
+
+#include "RenderServer.h"
+
+#if JUCE_LINUX
+ #include <pthread.h>
+ #include <sched.h>
+#endif
+
+class RenderServer::Worker  : public juce::Thread
+{
+public:
+    Worker(RenderServer& serverToUse, int index)
+        : juce::Thread("Render Worker " + juce::String(index)), server(serverToUse), workerIndex(index),
+          core(index % juce::SystemStats::getNumCpus())
+    {
+       #if ! JUCE_LINUX
+        // One worker per core; the affinity mask only covers the first 32 cores
+        if (core < 32)
+            setAffinityMask((juce::uint32) 1 << core);
+       #endif
+    }
+
+    ~Worker() override
+    {
+        stopThread(1000);
+    }
+
+    juce::int64 getNumStolenBlocks() const { return stolenBlocks.load(std::memory_order_relaxed); }
+
+    void run() override
+    {
+       #if JUCE_LINUX
+        // One worker per core; unlike the 32-bit mask of setAffinityMask, a cpu_set_t reaches every core
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(core, &cpus);
+
+        auto result = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+        jassert(result == 0);
+        juce::ignoreUnused(result);
+       #endif
+
+        // Prepared on this thread, so first-touch places the buffers of the streams this worker
+        // usually serves on its own NUMA node
+        for (auto i = server.getFirstHomeStream(workerIndex); i < server.getFirstHomeStream(workerIndex + 1); ++i)
+        {
+            auto& stream = *server.streams[(size_t) i];
+            auto& processor = *stream.processor;
+
+            // Hundreds of designer threads polling next to the pinned workers would skew every number;
+            // each stream designs on the worker that processes it instead
+            processor.getDesigner().setRunsInline(true);
+            processor.setNonRealtime(true);
+            processor.setPlayConfigDetails(numChannels, numChannels, server.sampleRate, server.blockSize);
+            processor.prepareToPlay(server.sampleRate, server.blockSize);
+
+            stream.input.prepare(numChannels, server.blockSize, queueCapacityInBlocks);
+            stream.output.prepare(numChannels, server.blockSize, queueCapacityInBlocks);
+        }
+
+        // Reused for every block this worker processes, whichever stream it belongs to
+        juce::AudioBuffer<float> scratch(numChannels, server.blockSize);
+
+        if (server.numPreparedWorkers.fetch_add(1) + 1 == server.getNumWorkers())
+            server.allPrepared.signal();
+
+        while (! threadShouldExit())
+        {
+            juce::int64 stolen = 0;
+
+            if (! server.processReadyStreams(workerIndex, scratch, stolen))
+                wait(1);
+
+            stolenBlocks.fetch_add(stolen, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    RenderServer& server;
+    const int workerIndex;
+    const int core;
+    std::atomic<juce::int64> stolenBlocks{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Worker)
+};
+
+//==============================================================================
+RenderServer::RenderServer(int numStreams, int numWorkers, double sampleRateToUse, int blockSizeToUse)
+    : sampleRate(sampleRateToUse), blockSize(blockSizeToUse)
+{
+    jassert(numStreams > 0 && numWorkers > 0);
+
+    for (int i = 0; i < numStreams; ++i)
+    {
+        auto stream = std::make_unique<Stream>();
+        stream->processor = std::make_unique<SimplePluginAudioProcessor>();
+        streams.push_back(std::move(stream));
+    }
+
+    for (int i = 0; i < numWorkers; ++i)
+        workers.push_back(std::make_unique<Worker>(*this, i));
+}
+
+RenderServer::~RenderServer()
+{
+    stop();
+}
+
+void RenderServer::start()
+{
+    numPreparedWorkers = 0;
+    allPrepared.reset();
+
+    for (auto& worker : workers)
+        worker->startThread();
+
+    allPrepared.wait();
+}
+
+void RenderServer::stop()
+{
+    // Ask everyone first, so the workers wind down in parallel
+    for (auto& worker : workers)
+        worker->signalThreadShouldExit();
+
+    for (auto& worker : workers)
+        worker->stopThread(1000);
+
+    for (auto& stream : streams)
+        stream->processor->releaseResources();
+}
+
+//==============================================================================
+bool RenderServer::pushInput(int streamIndex, const juce::AudioBuffer<float>& block) noexcept
+{
+    return streams[(size_t) streamIndex]->input.push(block);
+}
+
+bool RenderServer::popOutput(int streamIndex, juce::AudioBuffer<float>& block) noexcept
+{
+    return streams[(size_t) streamIndex]->output.pop(block);
+}
+
+juce::int64 RenderServer::getNumStolenBlocks() const
+{
+    juce::int64 total = 0;
+
+    for (auto& worker : workers)
+        total += worker->getNumStolenBlocks();
+
+    return total;
+}
+
+//==============================================================================
+int RenderServer::getFirstHomeStream(int workerIndex) const noexcept
+{
+    return (int) ((juce::int64) workerIndex * (juce::int64) streams.size() / (juce::int64) workers.size());
+}
+
+bool RenderServer::processReadyStreams(int workerIndex, juce::AudioBuffer<float>& scratch, juce::int64& stolenBlocks) noexcept
+{
+    auto numStreams = (int) streams.size();
+    auto firstHomeStream = getFirstHomeStream(workerIndex);
+    auto numHomeStreams = getFirstHomeStream(workerIndex + 1) - firstHomeStream;
+
+    juce::MidiBuffer midiMessages;
+    auto didWork = false;
+
+    for (int k = 0; k < numStreams; ++k)
+    {
+        auto& stream = *streams[(size_t) ((firstHomeStream + k) % numStreams)];
+
+        // Checked before claiming, so idle streams don't bounce their flag between cores
+        if (! stream.input.canPop() || ! stream.output.canPush())
+            continue;
+
+        if (stream.claimed.exchange(true, std::memory_order_acquire))
+            continue;
+
+        // Only the claiming worker consumes the input and produces the output, so both still hold
+        if (stream.input.pop(scratch))
+        {
+            stream.processor->processBlock(scratch, midiMessages);
+            stream.output.push(scratch);
+
+            didWork = true;
+
+            if (k >= numHomeStreams)
+                ++stolenBlocks;
+        }
+
+        stream.claimed.store(false, std::memory_order_release);
+    }
+
+    return didWork;
+}
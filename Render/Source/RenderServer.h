@@ -0,0 +1,83 @@
+/*
+  ==============================================================================
+
+    RenderServer.h
+
+    Runs many independent SimplePluginAudioProcessor instances ("streams")
+    across a pool of core-pinned worker threads. Every stream has an input
+    and an output SpscBlockQueue; a worker processes a stream whenever it
+    has an input block waiting and room for the result.
+
+    Each worker owns a contiguous range of streams and serves those first,
+    then steals ready streams from the other ranges, so uneven stream costs
+    don't leave cores idle. A stream is claimed with an atomic flag while a
+    block is processed, which keeps both of its queues single-consumer and
+    single-producer on the server side.
+
+    Streams carry no threads of their own: each designs its coefficients
+    inline on the worker that processes it, and its spectrum analyzer
+    holds no buffers since no editor ever watches it.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../Source/PluginProcessor.h"
+#include "SpscBlockQueue.h"
+
+class RenderServer
+{
+public:
+    RenderServer(int numStreams, int numWorkers, double sampleRate, int blockSize);
+    ~RenderServer();
+
+    int getNumStreams() const { return (int) streams.size(); }
+    int getNumWorkers() const { return (int) workers.size(); }
+
+    // Only valid before start(), e.g. to set parameters or restore a state
+    SimplePluginAudioProcessor& getProcessor(int streamIndex) { return *streams[(size_t) streamIndex]->processor; }
+
+    // Starts the workers and returns once each has prepared the streams it owns
+    void start();
+    void stop();
+
+    // =======Client=======
+    // One client thread per stream at a time; both return false instead of waiting
+    bool pushInput(int streamIndex, const juce::AudioBuffer<float>& block) noexcept;
+    bool popOutput(int streamIndex, juce::AudioBuffer<float>& block) noexcept;
+
+    // Number of blocks each worker took from another worker's range since start()
+    juce::int64 getNumStolenBlocks() const;
+
+    static constexpr int numChannels = 2;
+
+private:
+    struct Stream
+    {
+        std::unique_ptr<SimplePluginAudioProcessor> processor;
+        SpscBlockQueue input, output;
+        std::atomic<bool> claimed{ false };
+    };
+
+    class Worker;
+
+    // Processes every ready stream once, home range first; returns false if there was nothing to do
+    bool processReadyStreams(int workerIndex, juce::AudioBuffer<float>& scratch, juce::int64& stolenBlocks) noexcept;
+
+    int getFirstHomeStream(int workerIndex) const noexcept;
+
+    static constexpr int queueCapacityInBlocks = 4;
+
+    double sampleRate;
+    int blockSize;
+
+    std::vector<std::unique_ptr<Stream>> streams;
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    juce::WaitableEvent allPrepared;
+    std::atomic<int> numPreparedWorkers{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RenderServer)
+};
@@ -0,0 +1,120 @@
+/*
+  ==============================================================================
+
+    ScalingBenchmark.cpp
+
+  ==============================================================================
+*/
+
+#include "ScalingBenchmark.h"
+#include "RenderServer.h"
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+
+    juce::Array<int> getWorkerCounts()
+    {
+        juce::Array<int> counts;
+        auto numCores = juce::SystemStats::getNumCpus();
+
+        for (int count = 1; count < numCores; count *= 2)
+            counts.add(count);
+
+        counts.add(numCores);
+        return counts;
+    }
+
+    // Returns the wall clock time to render every stream
+    double measureServer(int numStreams, int numWorkers, int blockSize, juce::int64 blocksPerStream, ReverbEngine engine,
+                         juce::int64& stolenBlocks)
+    {
+        RenderServer server(numStreams, numWorkers, sampleRate, blockSize);
+
+        for (int i = 0; i < numStreams; ++i)
+        {
+            auto* parameter = server.getProcessor(i).apvts.getParameter(ParameterIDs::reverbEngine);
+            parameter->setValueNotifyingHost(parameter->convertTo0to1((float) engine));
+        }
+
+        server.start();
+
+        juce::AudioBuffer<float> input(RenderServer::numChannels, blockSize), output(RenderServer::numChannels, blockSize);
+        juce::Random random(0x5eed);
+
+        for (int channel = 0; channel < input.getNumChannels(); ++channel)
+            for (int i = 0; i < blockSize; ++i)
+                input.setSample(channel, i, random.nextFloat() * 2.0f - 1.0f);
+
+        std::vector<juce::int64> pushed((size_t) numStreams, 0), popped((size_t) numStreams, 0);
+        auto remaining = (juce::int64) numStreams * blocksPerStream;
+
+        auto start = juce::Time::getHighResolutionTicks();
+
+        // The client keeps every input queue topped up and drains every output queue; it spins on a core
+        // of its own, so the last row shares one core between the client and a worker
+        while (remaining > 0)
+        {
+            for (int i = 0; i < numStreams; ++i)
+            {
+                while (pushed[(size_t) i] < blocksPerStream && server.pushInput(i, input))
+                    ++pushed[(size_t) i];
+
+                while (server.popOutput(i, output))
+                {
+                    ++popped[(size_t) i];
+                    --remaining;
+                }
+            }
+        }
+
+        auto seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+        stolenBlocks = server.getNumStolenBlocks();
+        server.stop();
+
+        return seconds;
+    }
+}
+
+void runScalingBenchmark(int numStreams, double secondsPerStream, int blockSize)
+{
+    auto blocksPerStream = juce::jmax((juce::int64) 1, (juce::int64) (secondsPerStream * sampleRate / blockSize));
+    auto audioSeconds = (double) (blocksPerStream * blockSize) / sampleRate;
+
+    std::cout << "=== RenderServer scaling: " << numStreams << " streams x " << juce::String(audioSeconds, 1) << " s, block "
+              << blockSize << ", " << juce::SystemStats::getNumCpus() << " cores ===" << std::endl;
+
+    // Results only compare between runs on the same machine, so every run says which one it was
+    std::cout << "Machine: " << juce::SystemStats::getCpuModel() << ", " << juce::SystemStats::getNumPhysicalCpus()
+              << " physical cores, " << juce::SystemStats::getMemorySizeInMegabytes() << " MB, "
+              << juce::SystemStats::getOperatingSystemName() << std::endl;
+
+    for (auto engine : { ReverbEngine::Freeverb, ReverbEngine::FeedbackDelayNetwork })
+    {
+        std::cout << (engine == ReverbEngine::Freeverb ? "Freeverb" : "FDN") << std::endl;
+
+        double singleWorkerFactor = 0.0;
+
+        for (auto numWorkers : getWorkerCounts())
+        {
+            juce::int64 stolenBlocks = 0;
+            auto seconds = measureServer(numStreams, numWorkers, blockSize, blocksPerStream, engine, stolenBlocks);
+
+            // Seconds of audio rendered per wall clock second, summed over all streams
+            auto realTimeFactor = numStreams * audioSeconds / seconds;
+
+            if (numWorkers == 1)
+                singleWorkerFactor = realTimeFactor;
+
+            // Falls below 100 % once the workers contend for memory bandwidth or shared caches
+            auto efficiency = 100.0 * realTimeFactor / (singleWorkerFactor * numWorkers);
+
+            std::cout << "  workers " << juce::String(numWorkers).paddedLeft(' ', 3)
+                      << "  " << juce::String(realTimeFactor, 1).paddedLeft(' ', 9) << "x real time"
+                      << "  " << juce::String(realTimeFactor / numStreams, 2).paddedLeft(' ', 7) << "x per stream"
+                      << "  efficiency " << juce::String(efficiency, 0).paddedLeft(' ', 3) << " %"
+                      << "  stolen " << juce::String(stolenBlocks) << std::endl;
+        }
+    }
+}
@@ -0,0 +1,13 @@
+/*
+  ==============================================================================
+
+    ScalingBenchmark.h
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Pushes numStreams streams of noise through a RenderServer with 1, 2, 4, ... up to
+// all cores, once per reverb engine, and prints the aggregate real-time factor
+void runScalingBenchmark(int numStreams, double secondsPerStream, int blockSize);
@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    SpscBlockQueue.h
+
+    Fixed-size blocks of multichannel audio passed from one producer thread
+    to one consumer thread. All storage is allocated in prepare(), push()
+    and pop() only copy samples and move the AbstractFifo indices.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+class SpscBlockQueue
+{
+public:
+    SpscBlockQueue() = default;
+
+    // Not thread safe; call before either side starts using the queue
+    void prepare(int numChannels, int blockSizeToUse, int capacityInBlocks)
+    {
+        blockSize = blockSizeToUse;
+        storage.setSize(numChannels, blockSize * capacityInBlocks);
+        storage.clear();
+
+        // AbstractFifo keeps one slot free to tell full from empty
+        fifo.setTotalSize(capacityInBlocks + 1);
+        fifo.reset();
+    }
+
+    // =======Producer=======
+    bool canPush() const noexcept { return fifo.getFreeSpace() > 0; }
+
+    // Copies one block in; returns false without copying when the queue is full
+    bool push(const juce::AudioBuffer<float>& block) noexcept
+    {
+        jassert(block.getNumSamples() == blockSize && block.getNumChannels() >= storage.getNumChannels());
+
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite(1, start1, size1, start2, size2);
+
+        if (size1 + size2 == 0)
+            return false;
+
+        auto slot = size1 > 0 ? start1 : start2;
+
+        for (int channel = 0; channel < storage.getNumChannels(); ++channel)
+            storage.copyFrom(channel, slot * blockSize, block, channel, 0, blockSize);
+
+        fifo.finishedWrite(1);
+        return true;
+    }
+
+    // =======Consumer=======
+    bool canPop() const noexcept { return fifo.getNumReady() > 0; }
+
+    // Copies the oldest block out; returns false without touching block when the queue is empty
+    bool pop(juce::AudioBuffer<float>& block) noexcept
+    {
+        jassert(block.getNumSamples() >= blockSize && block.getNumChannels() >= storage.getNumChannels());
+
+        int start1, size1, start2, size2;
+        fifo.prepareToRead(1, start1, size1, start2, size2);
+
+        if (size1 + size2 == 0)
+            return false;
+
+        auto slot = size1 > 0 ? start1 : start2;
+
+        for (int channel = 0; channel < storage.getNumChannels(); ++channel)
+            block.copyFrom(channel, 0, storage, channel, slot * blockSize, blockSize);
+
+        fifo.finishedRead(1);
+        return true;
+    }
+
+private:
+    juce::AbstractFifo fifo{ 1 };
+    juce::AudioBuffer<float> storage;
+    int blockSize{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpscBlockQueue)
+};
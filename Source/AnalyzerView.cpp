@@ -0,0 +1,157 @@
+/*
+  ==============================================================================
+
+    AnalyzerView.cpp
+
+  ==============================================================================
+*/
+
+#include "AnalyzerView.h"
+
+AnalyzerView::AnalyzerView(SpectrumAnalyzer& analyzerToShow, CoefficientDesigner& designerToShow)
+    : analyzer(analyzerToShow), designer(designerToShow)
+{
+    setOpaque(true);
+
+    // Starts the analysis thread; the audio thread only feeds it while a view is attached
+    analyzer.addViewer();
+    wasEnabled = analyzer.isEnabled();
+}
+
+AnalyzerView::~AnalyzerView()
+{
+    analyzer.removeViewer();
+}
+
+void AnalyzerView::resized()
+{
+    analyzer.setNumColumns(getWidth());
+
+    for (auto& path : spectrumPaths)
+        path.clear();
+
+    // The grid is rebuilt for the new width; the last published set is still valid
+    updateResponsePath(designer.getDisplayed());
+}
+
+void AnalyzerView::update()
+{
+    auto needsRepaint = false;
+
+    if (designer.pullDisplayed())
+    {
+        updateResponsePath(designer.getDisplayed());
+        needsRepaint = true;
+    }
+
+    auto isEnabled = analyzer.isEnabled();
+
+    if (isEnabled != wasEnabled)
+    {
+        wasEnabled = isEnabled;
+
+        for (auto& path : spectrumPaths)
+            path.clear();
+
+        needsRepaint = true;
+    }
+
+    if (isEnabled && analyzer.pullSpectrum())
+    {
+        const auto& spectrum = analyzer.getSpectrum();
+
+        // A frame analysed for the previous width is dropped, the next one will fit
+        if (spectrum.numColumns == getWidth())
+        {
+            updateSpectrumPaths(spectrum);
+            needsRepaint = true;
+        }
+    }
+
+    if (needsRepaint)
+        repaint();
+}
+
+void AnalyzerView::updateSpectrumPaths(const SpectrumAnalyzer::Spectrum& spectrum)
+{
+    for (int tap = 0; tap < SpectrumAnalyzer::numTaps; ++tap)
+    {
+        auto& path = spectrumPaths[(size_t) tap];
+        const auto& levels = spectrum.levels[(size_t) tap];
+
+        // Keeps its storage from the previous frame, so this doesn't allocate once the size has settled
+        path.clear();
+        path.startNewSubPath(0.0f, getYForDecibels(levels[0]));
+
+        for (int column = 1; column < spectrum.numColumns; ++column)
+            path.lineTo((float) column, getYForDecibels(levels[(size_t) column]));
+    }
+}
+
+void AnalyzerView::updateResponsePath(const ChainCoefficients& chainCoefficients)
+{
+    responsePath.clear();
+
+    if (getWidth() == 0)
+        return;
+
+    // One point per pixel column, on the same frequency axis as the spectrum
+    responseCurve.setGrid(getWidth(), chainCoefficients.sampleRate, SpectrumAnalyzer::minFrequency, SpectrumAnalyzer::maxFrequency);
+    responseCurve.compute(chainCoefficients);
+
+    const auto* decibels = responseCurve.getDecibels();
+    responsePath.startNewSubPath(0.0f, getYForResponse(decibels[0]));
+
+    for (int column = 1; column < responseCurve.getNumPoints(); ++column)
+        responsePath.lineTo((float) column, getYForResponse(decibels[column]));
+}
+
+float AnalyzerView::getXForFrequency(float frequency) const noexcept
+{
+    return (float) getWidth() * std::log(frequency / SpectrumAnalyzer::minFrequency)
+                              / std::log(SpectrumAnalyzer::maxFrequency / SpectrumAnalyzer::minFrequency);
+}
+
+float AnalyzerView::getYForDecibels(float decibels) const noexcept
+{
+    return juce::jmap(juce::jlimit(minDecibels, maxDecibels, decibels), maxDecibels, minDecibels, 0.0f, (float) getHeight());
+}
+
+float AnalyzerView::getYForResponse(float decibels) const noexcept
+{
+    // Clamped a little outside the view, so steep cuts run off the bottom edge instead of along it
+    auto limit = responseRangeDecibels * 1.1f;
+    return juce::jmap(juce::jlimit(-limit, limit, decibels), responseRangeDecibels, -responseRangeDecibels, 0.0f, (float) getHeight());
+}
+
+void AnalyzerView::paint(juce::Graphics& g)
+{
+    g.fillAll(juce::Colours::black);
+
+    // Grid: decades and octaves of 1 kHz, 12 dB steps
+    g.setColour(juce::Colours::white.withAlpha(0.1f));
+
+    for (auto frequency : { 50.0f, 100.0f, 200.0f, 500.0f, 1000.0f, 2000.0f, 5000.0f, 10000.0f })
+        g.drawVerticalLine(juce::roundToInt(getXForFrequency(frequency)), 0.0f, (float) getHeight());
+
+    for (auto decibels = maxDecibels; decibels > minDecibels; decibels -= 12.0f)
+        g.drawHorizontalLine(juce::roundToInt(getYForDecibels(decibels)), 0.0f, (float) getWidth());
+
+    if (analyzer.isEnabled())
+    {
+        g.setColour(juce::Colours::grey);
+        g.strokePath(spectrumPaths[SpectrumAnalyzer::preEq], juce::PathStrokeType(1.0f));
+
+        g.setColour(juce::Colours::orange);
+        g.strokePath(spectrumPaths[SpectrumAnalyzer::postEq], juce::PathStrokeType(1.5f));
+    }
+    else
+    {
+        g.setColour(juce::Colours::grey);
+        g.setFont(12.0f);
+        g.drawText("Analyzer off", getLocalBounds().reduced(4), juce::Justification::topRight);
+    }
+
+    g.setColour(juce::Colours::white);
+    g.strokePath(responsePath, juce::PathStrokeType(2.0f));
+}
@@ -0,0 +1,66 @@
+/*
+  ==============================================================================
+
+    AnalyzerView.h
+
+    Pre- and post-EQ spectrum from the SpectrumAnalyzer, with the magnitude
+    response of the current EQ on top. The spectra arrive already reduced
+    to one level per pixel column and the response is only re-evaluated
+    when the designer publishes new EQ coefficients; both are turned into
+    cached paths, so paint() only strokes them.
+
+    Updates are polled on the display's vertical blank and a repaint is
+    only requested when something changed, so the view never repaints
+    faster than the screen refreshes.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "CoefficientDesigner.h"
+#include "ResponseCurve.h"
+#include "SpectrumAnalyzer.h"
+
+class AnalyzerView  : public juce::Component
+{
+public:
+    AnalyzerView(SpectrumAnalyzer& analyzerToShow, CoefficientDesigner& designerToShow);
+    ~AnalyzerView() override;
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+    static constexpr int preferredHeight = 200;
+
+    // Display range of the levels
+    static constexpr float maxDecibels = 12.0f;
+    static constexpr float minDecibels = -84.0f;
+
+    // The response curve gets its own, finer scale around 0 dB
+    static constexpr float responseRangeDecibels = 24.0f;
+
+private:
+    void update();
+
+    void updateSpectrumPaths(const SpectrumAnalyzer::Spectrum& spectrum);
+    void updateResponsePath(const ChainCoefficients& chainCoefficients);
+
+    float getXForFrequency(float frequency) const noexcept;
+    float getYForDecibels(float decibels) const noexcept;
+    float getYForResponse(float decibels) const noexcept;
+
+    SpectrumAnalyzer& analyzer;
+    CoefficientDesigner& designer;
+
+    std::array<juce::Path, SpectrumAnalyzer::numTaps> spectrumPaths;
+    bool wasEnabled{ true };
+
+    ResponseCurve responseCurve;
+    juce::Path responsePath;
+
+    juce::VBlankAttachment vBlankAttachment{ this, [this] { update(); } };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AnalyzerView)
+};
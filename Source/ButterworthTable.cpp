@@ -0,0 +1,126 @@
+/*
+  ==============================================================================
+
+    ButterworthTable.cpp
+
+  ==============================================================================
+*/
+
+#include "ButterworthTable.h"
+#include "CoefficientDesigner.h"
+#include "SharedResources.h"
+
+ButterworthTable::ButterworthTable(double sampleRateToUse)
+    : sampleRate(sampleRateToUse),
+      // Cut-offs close to Nyquist can't be designed at all; low sample rates get a shorter table
+      highestFrequency(juce::jmin((double) maxFrequency, sampleRateToUse * 0.49))
+{
+    firstPoint = getWarpedFrequency(minFrequency);
+
+    auto span = getWarpedFrequency(highestFrequency) - firstPoint;
+    numPoints = juce::jmax(2, (int) std::ceil(span * pointsPerOctave) + 1);
+    pointSpacing = span / (numPoints - 1);
+
+    using Design = juce::dsp::FilterDesign<double>;
+
+    auto addSections = [](std::vector<Section>& table, const auto& designed)
+    {
+        for (const auto& section : designed)
+        {
+            auto* raw = section->getRawCoefficients();
+            table.push_back({ raw[0], raw[1], raw[2], raw[3], raw[4] });
+        }
+    };
+
+    for (int slope = 0; slope < numSlopes; ++slope)
+    {
+        auto order = 2 * (slope + 1);
+        auto& highpassTable = tables[highpass][(size_t) slope];
+        auto& lowpassTable = tables[lowpass][(size_t) slope];
+
+        highpassTable.reserve((size_t) (numPoints * (slope + 1)));
+        lowpassTable.reserve((size_t) (numPoints * (slope + 1)));
+
+        for (int point = 0; point < numPoints; ++point)
+        {
+            // Back from the prewarped grid to Hz
+            auto frequency = std::atan(std::exp2(firstPoint + point * pointSpacing)) * sampleRate / juce::MathConstants<double>::pi;
+
+            addSections(highpassTable, Design::designIIRHighpassHighOrderButterworthMethod(frequency, sampleRate, order));
+            addSections(lowpassTable, Design::designIIRLowpassHighOrderButterworthMethod(frequency, sampleRate, order));
+        }
+    }
+}
+
+std::shared_ptr<const ButterworthTable> ButterworthTable::getShared(double sampleRate)
+{
+    return SharedResources::get<ButterworthTable>("ButterworthTable/" + juce::String(sampleRate), [sampleRate]
+    {
+        return std::make_shared<ButterworthTable>(sampleRate);
+    });
+}
+
+size_t ButterworthTable::getSizeInBytes() const noexcept
+{
+    auto numBytes = sizeof(*this);
+
+    for (const auto& typeTables : tables)
+        for (const auto& table : typeTables)
+            numBytes += table.capacity() * sizeof(Section);
+
+    return numBytes;
+}
+
+//==============================================================================
+bool ButterworthTable::getHighpass(float frequency, Slope slope, BiquadCoefficients* sections) const noexcept
+{
+    return interpolate(highpass, frequency, slope, sections);
+}
+
+bool ButterworthTable::getLowpass(float frequency, Slope slope, BiquadCoefficients* sections) const noexcept
+{
+    return interpolate(lowpass, frequency, slope, sections);
+}
+
+bool ButterworthTable::getHighpass(float frequency, Slope slope, Section* sections) const noexcept
+{
+    return interpolate(highpass, frequency, slope, sections);
+}
+
+bool ButterworthTable::getLowpass(float frequency, Slope slope, Section* sections) const noexcept
+{
+    return interpolate(lowpass, frequency, slope, sections);
+}
+
+double ButterworthTable::getWarpedFrequency(double frequency) const noexcept
+{
+    return std::log2(std::tan(juce::MathConstants<double>::pi * frequency / sampleRate));
+}
+
+template <typename Output>
+bool ButterworthTable::interpolate(Type type, float frequency, Slope slope, Output* sections) const noexcept
+{
+    if (frequency < minFrequency || frequency > highestFrequency)
+        return false;
+
+    auto position = (getWarpedFrequency(frequency) - firstPoint) / pointSpacing;
+    auto point = juce::jlimit(0, numPoints - 2, (int) position);
+    auto fraction = position - point;
+
+    auto numSections = (int) slope + 1;
+    const auto* lower = tables[type][(size_t) slope].data() + point * numSections;
+    const auto* upper = lower + numSections;
+
+    using Value = decltype(Output::b0);
+    auto lerp = [fraction](double a, double b) { return (Value) (a + (b - a) * fraction); };
+
+    for (int i = 0; i < numSections; ++i)
+    {
+        const auto& a = lower[i];
+        const auto& b = upper[i];
+
+        sections[i] = { lerp(a.b0, b.b0), lerp(a.b1, b.b1), lerp(a.b2, b.b2), lerp(a.a1, b.a1), lerp(a.a2, b.a2) };
+    }
+
+    return true;
+}
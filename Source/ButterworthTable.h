@@ -0,0 +1,87 @@
+/*
+  ==============================================================================
+
+    ButterworthTable.h
+
+    The low cut and high cut sections of every slope, designed ahead of time
+    on a dense grid of cut-off frequencies for one sample rate. A cut-off
+    between two grid points is linearly interpolated, coefficient by
+    coefficient, which costs one tan and a few multiplies instead of the
+    trig, pole placement and allocations of a full FilterDesign.
+
+    The grid is uniform in the prewarped frequency log2(tan(pi f / fs)), so
+    it gets denser towards Nyquist where the coefficients change fastest.
+    Tables are shared by every instance running at the same rate.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ChainSettings.h"
+
+struct BiquadCoefficients;
+
+class ButterworthTable
+{
+public:
+    static constexpr float minFrequency = 20.0f;
+    static constexpr float maxFrequency = 20000.0f;
+    static constexpr int pointsPerOctave = 24;
+
+    // The grid is designed with FilterDesign<double>, while the exact path of CoefficientDesigner uses
+    // FilterDesign<float>. maxErrorDecibels bounds the full-precision interpolation against
+    // FilterDesign<double>, wherever the exact response is above -20 dB; the grid error falls with
+    // pointsPerOctave squared. The float sections the filters get may add float rounding on top, so
+    // they are held to FilterDesign<float>'s own error against the double design plus the same bound.
+    // Both are checked by the design benchmark.
+    static constexpr double maxErrorDecibels = 0.05;
+
+    // Kept in double so the interpolation adds no rounding of its own
+    struct Section
+    {
+        double b0, b1, b2, a1, a2;
+    };
+
+    explicit ButterworthTable(double sampleRate);
+
+    // Built on first use for each rate, then shared; message thread
+    static std::shared_ptr<const ButterworthTable> getShared(double sampleRate);
+
+    // Write slope + 1 sections. Return false for cut-offs outside the table, which need the exact design.
+    bool getHighpass(float frequency, Slope slope, BiquadCoefficients* sections) const noexcept;
+    bool getLowpass(float frequency, Slope slope, BiquadCoefficients* sections) const noexcept;
+
+    // Full precision, for checking the table against the exact design
+    bool getHighpass(float frequency, Slope slope, Section* sections) const noexcept;
+    bool getLowpass(float frequency, Slope slope, Section* sections) const noexcept;
+
+    int getNumPoints() const noexcept { return numPoints; }
+    size_t getSizeInBytes() const noexcept;
+
+private:
+    enum Type
+    {
+        highpass,
+        lowpass,
+        numTypes
+    };
+
+    static constexpr int numSlopes = Slope_48 + 1;
+
+    double getWarpedFrequency(double frequency) const noexcept;
+
+    template <typename Output>
+    bool interpolate(Type type, float frequency, Slope slope, Output* sections) const noexcept;
+
+    double sampleRate;
+    double highestFrequency;
+    double firstPoint{ 0.0 }, pointSpacing{ 1.0 };
+    int numPoints{ 0 };
+
+    // Per type and slope, numPoints rows of slope + 1 sections
+    std::array<std::array<std::vector<Section>, numSlopes>, numTypes> tables;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ButterworthTable)
+};
@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    ChainSettings.h
+
+    Snapshot of every parameter that shapes the processing chain.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+enum Slope
+{
+    Slope_12,
+    Slope_24,
+    Slope_36,
+    Slope_48
+};
+
+enum EqEngine
+{
+    Biquad,
+    StateVariable
+};
+
+enum ReverbEngine
+{
+    Freeverb,
+    FeedbackDelayNetwork,
+    Convolution
+};
+
+struct ChainSettings
+{
+    //EQ
+    float peakFreq{ 0 }, peakGainInDecibels{ 0 }, peakQuality{ 1.f };
+    float lowCutFreq{ 0 }, highCutFreq{ 0 };
+    Slope lowCutSlope{ Slope::Slope_12 }, highCutSlope{ Slope::Slope_12 };
+
+    bool inputEqBypassed{ false };
+    bool lowCutBypassed{ false };
+    bool peakBypassed{ false };
+    bool HighCutBypassed{ false };
+
+    EqEngine eqEngine{ EqEngine::Biquad };
+
+    //Reverb
+    float mix{ 1.f };
+    float roomSize{ 0.5f };
+    float damping{ 0.5f };
+    float preDelay{ 0 }; // ms
+    float low{ 0 };
+    ReverbEngine reverbEngine{ ReverbEngine::Freeverb };
+
+    bool AnalyzerEnabled { true };
+    
+
+};
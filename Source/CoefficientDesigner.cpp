@@ -0,0 +1,302 @@
+/*
+  ==============================================================================
+
+    CoefficientDesigner.cpp
+
+  ==============================================================================
+*/
+
+#include "CoefficientDesigner.h"
+#include "ButterworthTable.h"
+#include "CustomReverb.h"
+
+CoefficientDesigner::CoefficientDesigner(juce::AudioProcessorValueTreeState& apvts)
+    : juce::Thread("Coefficient Designer"), parameters(apvts)
+{
+}
+
+CoefficientDesigner::~CoefficientDesigner()
+{
+    release();
+}
+
+//==============================================================================
+void CoefficientDesigner::prepare(double newSampleRate)
+{
+    {
+        const juce::ScopedLock lock(designLock);
+
+        sampleRate = newSampleRate;
+        cutTable = ButterworthTable::getShared(sampleRate);
+        dirtyStages.store(0);
+        designAndPublish(allStages, parameters.load(), batchGeneration.load());
+    }
+
+    if (runsInline)
+        stopThread(1000);
+    else if (! isThreadRunning())
+        startThread();
+}
+
+void CoefficientDesigner::release()
+{
+    stopThread(1000);
+}
+
+//==============================================================================
+void CoefficientDesigner::markDirty(uint32_t stages)
+{
+    dirtyStages.fetch_or(stages);
+
+    // notify() takes the event's mutex, which the audio thread must never do; automation
+    // arriving there waits at most pollIntervalMs for the designer to see it
+    if (juce::MessageManager::existsAndIsCurrentThread())
+        notify();
+}
+
+uint32_t CoefficientDesigner::beginParameterBatch() noexcept
+{
+    batchesInProgress.fetch_add(1);
+    return batchGeneration.fetch_add(1) + 1;
+}
+
+void CoefficientDesigner::endParameterBatch() noexcept
+{
+    jassert(batchesInProgress.load() > 0);
+    batchesInProgress.fetch_sub(1);
+}
+
+bool CoefficientDesigner::loadOutsideBatch(ChainSettings& chainSettings, uint32_t& generation) const noexcept
+{
+    generation = batchGeneration.load();
+
+    if (batchesInProgress.load() > 0)
+        return false;
+
+    chainSettings = parameters.load();
+
+    // A batch that began while the parameters were being read may have changed some of them
+    return batchesInProgress.load() == 0 && batchGeneration.load() == generation;
+}
+
+uint32_t CoefficientDesigner::getStagesForParameter(const juce::String& parameterID)
+{
+    if (parameterID == ParameterIDs::lowCutFreq || parameterID == ParameterIDs::lowCutSlope || parameterID == ParameterIDs::lowCutBypassed)
+        return lowCutStage;
+
+    if (parameterID == ParameterIDs::highCutFreq || parameterID == ParameterIDs::highCutSlope || parameterID == ParameterIDs::highCutBypassed)
+        return highCutStage;
+
+    if (parameterID == ParameterIDs::peakFreq || parameterID == ParameterIDs::peakGain || parameterID == ParameterIDs::peakQuality
+        || parameterID == ParameterIDs::peakBypassed)
+        return peakStage;
+
+    if (parameterID == ParameterIDs::inputEqBypassed || parameterID == ParameterIDs::eqEngine)
+        return equaliserStages;
+
+    if (parameterID == ParameterIDs::mix || parameterID == ParameterIDs::roomSize || parameterID == ParameterIDs::damping
+        || parameterID == ParameterIDs::reverbEngine || parameterID == ParameterIDs::preDelay)
+        return reverbStage;
+
+    // Display only, nothing to design
+    if (parameterID == ParameterIDs::analyzerEnabled)
+        return 0;
+
+    // Unknown parameters conservatively invalidate everything
+    jassertfalse;
+    return allStages;
+}
+
+//==============================================================================
+void CoefficientDesigner::run()
+{
+    windowStart = juce::Time::getMillisecondCounter();
+
+    while (! threadShouldExit())
+    {
+        wait(pollIntervalMs);
+        designPending();
+    }
+}
+
+void CoefficientDesigner::designPending()
+{
+    auto stages = dirtyStages.exchange(0);
+
+   #if SIMPLEPLUGIN_ALWAYS_REDESIGN
+    // Reference behaviour for comparing the redesign counter against designing on every update
+    stages = allStages;
+   #endif
+
+    const juce::ScopedLock lock(designLock);
+
+    if (stages != 0)
+    {
+        ChainSettings chainSettings;
+        uint32_t generation;
+
+        // Mid-batch: keep the stages dirty and try again on the next poll
+        if (loadOutsideBatch(chainSettings, generation))
+            designAndPublish(stages, chainSettings, generation);
+        else
+            dirtyStages.fetch_or(stages);
+    }
+
+    countRedesigns(0);
+}
+
+void CoefficientDesigner::designAndPublish(uint32_t stages, const ChainSettings& chainSettings, uint32_t generation)
+{
+    auto numRedesigns = design(current, chainSettings, sampleRate, stages, cutTable.get());
+    current.parameterGeneration = generation;
+
+    coefficients.getWriteBuffer() = current;
+    coefficients.publish();
+
+    if (stages & equaliserStages)
+    {
+        displayedCoefficients.getWriteBuffer() = current;
+        displayedCoefficients.publish();
+    }
+
+    countRedesigns(numRedesigns);
+}
+
+int CoefficientDesigner::design(ChainCoefficients& dest, const ChainSettings& chainSettings, double sampleRateToUse, uint32_t stages,
+                                const ButterworthTable* cutTable)
+{
+    int numRedesigns = 0;
+
+    dest.sampleRate = sampleRateToUse;
+
+    if (stages & equaliserStages)
+        dest.eqEngine = chainSettings.eqEngine;
+
+    //Lowcut
+    if (stages & lowCutStage)
+    {
+        if (cutTable == nullptr || ! cutTable->getHighpass(chainSettings.lowCutFreq, chainSettings.lowCutSlope, dest.lowCut.data()))
+        {
+            auto lowCutCoefficients = juce::dsp::FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod(chainSettings.lowCutFreq, sampleRateToUse, 2 * (chainSettings.lowCutSlope + 1));
+
+            for (int i = 0; i < lowCutCoefficients.size(); ++i)
+                copyCoefficients(dest.lowCut[(size_t) i], *lowCutCoefficients[i]);
+        }
+
+        dest.lowCutSlope = chainSettings.lowCutSlope;
+        dest.lowCutFrequency = chainSettings.lowCutFreq;
+        dest.lowCutActive = ! (chainSettings.inputEqBypassed || chainSettings.lowCutBypassed
+                               || chainSettings.lowCutFreq <= transparentLowCutFrequency);
+        ++numRedesigns;
+    }
+
+    //Peak
+    if (stages & peakStage)
+    {
+        auto peakCoefficients = juce::dsp::IIR::Coefficients<float>::makePeakFilter(sampleRateToUse, chainSettings.peakFreq, chainSettings.peakQuality, juce::Decibels::decibelsToGain(chainSettings.peakGainInDecibels));
+
+        copyCoefficients(dest.peak, *peakCoefficients);
+        dest.peakFrequency = chainSettings.peakFreq;
+        dest.peakGainInDecibels = chainSettings.peakGainInDecibels;
+        dest.peakQuality = chainSettings.peakQuality;
+        dest.peakActive = ! (chainSettings.inputEqBypassed || chainSettings.peakBypassed
+                             || std::abs(chainSettings.peakGainInDecibels) < transparentPeakDecibels);
+        ++numRedesigns;
+    }
+
+    //Highcut
+    if (stages & highCutStage)
+    {
+        if (cutTable == nullptr || ! cutTable->getLowpass(chainSettings.highCutFreq, chainSettings.highCutSlope, dest.highCut.data()))
+        {
+            auto highCutCoefficients = juce::dsp::FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod(chainSettings.highCutFreq, sampleRateToUse, 2 * (chainSettings.highCutSlope + 1));
+
+            for (int i = 0; i < highCutCoefficients.size(); ++i)
+                copyCoefficients(dest.highCut[(size_t) i], *highCutCoefficients[i]);
+        }
+
+        dest.highCutSlope = chainSettings.highCutSlope;
+        dest.highCutFrequency = chainSettings.highCutFreq;
+        dest.highCutActive = ! (chainSettings.inputEqBypassed || chainSettings.HighCutBypassed
+                                || chainSettings.highCutFreq >= transparentHighCutFrequency);
+        ++numRedesigns;
+    }
+
+    //Reverb
+    if (stages & reverbStage)
+    {
+        dest.reverb.roomSize = chainSettings.roomSize;
+        dest.reverb.damping = chainSettings.damping;
+        dest.reverb.wetLevel = chainSettings.mix;
+        dest.reverb.dryLevel = 0.0f;
+        dest.reverb.freezeMode = 0.0f;
+        dest.reverb.width = 1.0f;
+        dest.reverbEngine = chainSettings.reverbEngine;
+        dest.dryLevel = (chainSettings.reverbEngine == ReverbEngine::Freeverb ? freeverbDryScale : 1.0f) * (1.0f - chainSettings.mix);
+        dest.preDelaySeconds = chainSettings.preDelay * 0.001f;
+
+        switch (chainSettings.reverbEngine)
+        {
+            case ReverbEngine::FeedbackDelayNetwork:
+                dest.reverbTailSeconds = CustomReverb::getTailSeconds(chainSettings.roomSize, chainSettings.damping, reverbTailDecibels);
+                break;
+
+            case ReverbEngine::Convolution:
+                dest.reverbTailSeconds = 0.0;
+                break;
+
+            case ReverbEngine::Freeverb:
+            default:
+                dest.reverbTailSeconds = getFreeverbTailSeconds(chainSettings.roomSize, chainSettings.damping, reverbTailDecibels);
+                break;
+        }
+
+        ++numRedesigns;
+    }
+
+    return numRedesigns;
+}
+
+void CoefficientDesigner::countRedesigns(int numRedesigns)
+{
+    redesignsInWindow += numRedesigns;
+
+    auto now = juce::Time::getMillisecondCounter();
+
+    if (now - windowStart >= 1000)
+    {
+        redesignsPerSecond.store(redesignsInWindow, std::memory_order_relaxed);
+        redesignsInWindow = 0;
+        windowStart = now;
+    }
+}
+
+double CoefficientDesigner::getFreeverbTailSeconds(float roomSize, float damping, float decibels)
+{
+    // juce::dsp::Reverb's tunings in samples at 44.1 kHz, which it scales to the actual rate:
+    // the longest comb including the stereo spread, and the four allpasses in series
+    constexpr double longestComb = 1617.0 + 23.0;
+    constexpr double allpassChain = 556.0 + 441.0 + 341.0 + 225.0;
+    constexpr double allpassFeedback = 0.5;
+    constexpr double tuningSampleRate = 44100.0;
+
+    // Same scaling as juce::dsp::Reverb::setParameters()
+    auto feedback = (double) roomSize * 0.28 + 0.7;
+    auto damp = (double) damping * 0.4;
+
+    // The comb's damping lowpass has unity gain at DC, so the lows decay slowest; its group delay
+    // at DC lengthens each trip round the comb
+    auto combPasses = (double) decibels / (20.0 * std::log10(feedback));
+    auto allpassPasses = (double) decibels / (20.0 * std::log10(allpassFeedback));
+
+    return (combPasses * (longestComb + damp / (1.0 - damp)) + allpassPasses * allpassChain) / tuningSampleRate;
+}
+
+void CoefficientDesigner::copyCoefficients(BiquadCoefficients& dest, const juce::dsp::IIR::Coefficients<float>& source)
+{
+    // Every section produced by FilterDesign and makePeakFilter is second order
+    jassert(source.getFilterOrder() == 2);
+
+    auto* raw = source.getRawCoefficients();
+    dest = { raw[0], raw[1], raw[2], raw[3], raw[4] };
+}
@@ -0,0 +1,172 @@
+/*
+  ==============================================================================
+
+    CoefficientDesigner.h
+
+    Designs filter coefficients and reverb parameters away from the audio
+    thread and publishes complete sets through a TripleBuffer.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ChainSettings.h"
+#include "ParameterHandles.h"
+#include "TripleBuffer.h"
+
+class ButterworthTable;
+
+// Normalised second order section (a0 == 1), same layout as IIR::Coefficients::getRawCoefficients()
+struct BiquadCoefficients
+{
+    float b0{ 1.f }, b1{ 0.f }, b2{ 0.f }, a1{ 0.f }, a2{ 0.f };
+};
+
+// Everything the audio thread needs to configure the chain, free of heap-owned members
+struct ChainCoefficients
+{
+    static constexpr int maxCutSections = 4;
+
+    std::array<BiquadCoefficients, maxCutSections> lowCut, highCut;
+    BiquadCoefficients peak;
+    Slope lowCutSlope{ Slope::Slope_12 }, highCutSlope{ Slope::Slope_12 };
+
+    // False while a stage is bypassed or transparent; inactive stages are skipped, not run as unity filters
+    bool lowCutActive{ true }, peakActive{ true }, highCutActive{ true };
+
+    // The settings behind the EQ coefficients, for the glides of the state-variable engine and the control-rate smoother
+    EqEngine eqEngine{ EqEngine::Biquad };
+    float lowCutFrequency{ 20.f }, highCutFrequency{ 20000.f };
+    float peakFrequency{ 750.f }, peakGainInDecibels{ 0.f }, peakQuality{ 1.f };
+
+    // The reverb engines only produce the wet signal; the dry path is mixed back in after the pre-delay
+    juce::dsp::Reverb::Parameters reverb;
+    ReverbEngine reverbEngine{ ReverbEngine::Freeverb };
+    float dryLevel{ 0.f };
+    float preDelaySeconds{ 0.f };
+
+    // Tail of the algorithmic engines down to reverbTailDecibels, without the pre-delay;
+    // the convolution's tail is the length of its impulse response
+    double reverbTailSeconds{ 0.0 };
+
+    double sampleRate{ 44100.0 };
+
+    // Parameter batch generation the settings were read under; see beginParameterBatch()
+    uint32_t parameterGeneration{ 0 };
+};
+
+class CoefficientDesigner  : private juce::Thread
+{
+public:
+    // One bit per stage of the chain
+    enum Stage : uint32_t
+    {
+        lowCutStage     = 1u << 0,
+        peakStage       = 1u << 1,
+        highCutStage    = 1u << 2,
+        reverbStage     = 1u << 3,
+        equaliserStages = lowCutStage | peakStage | highCutStage,
+        allStages       = equaliserStages | reverbStage
+    };
+
+    explicit CoefficientDesigner(juce::AudioProcessorValueTreeState& apvts);
+    ~CoefficientDesigner() override;
+
+    // =======Message thread=======
+    // Designs every stage for the new sample rate before returning, then keeps the designer thread running
+    // unless the designer runs inline
+    void prepare(double sampleRate);
+    void release();
+
+    // For offline hosts that run many instances: no thread of its own, the owner calls designPending()
+    // before each block instead. Set before prepare().
+    void setRunsInline(bool shouldRunInline) noexcept { runsInline = shouldRunInline; }
+    bool isRunningInline() const noexcept { return runsInline; }
+
+    // Designs and publishes whatever was marked dirty since the last call; takes a lock and may allocate,
+    // so only for an owner whose processing thread isn't real-time
+    void designPending();
+
+    // =======Any thread=======
+    // Marks the stages; lock-free, so host automation may call it on the audio thread. Only a change
+    // on the message thread wakes the designer straight away, the others are picked up by the next poll.
+    void markDirty(uint32_t stages);
+    static uint32_t getStagesForParameter(const juce::String& parameterID);
+
+    // Brackets a burst of parameter writes that only make sense together (a preset, a saved state).
+    // The designer thread never publishes a set whose parameters were read during a batch, and
+    // stamps every set with the generation it was read under. Returns the batch's generation.
+    uint32_t beginParameterBatch() noexcept;
+    void endParameterBatch() noexcept;
+
+    // Designs the requested stages of dest for the given settings and returns how many were redesigned.
+    // With a table for sampleRateToUse, the cut filters are interpolated from it instead of designed.
+    static int design(ChainCoefficients& dest, const ChainSettings& chainSettings, double sampleRateToUse, uint32_t stages,
+                      const ButterworthTable* cutTable = nullptr);
+
+    // Settings at which a stage is treated as transparent: cut-offs at the ends of their ranges, a flat peak
+    static constexpr float transparentLowCutFrequency = 20.0f;
+    static constexpr float transparentHighCutFrequency = 20000.0f;
+    static constexpr float transparentPeakDecibels = 0.01f;
+
+    // Level relative to the input at which the reported reverb tail ends
+    static constexpr float reverbTailDecibels = -90.0f;
+
+    // juce::Reverb doubles its dry level internally; the separate dry path keeps that balance for Freeverb
+    static constexpr float freeverbDryScale = 2.0f;
+
+    // Number of stage redesigns during the last second
+    int getRedesignsPerSecond() const { return redesignsPerSecond.load(std::memory_order_relaxed); }
+
+    // =======Audio thread=======
+    // Returns true if a newer set was published; never blocks or allocates
+    bool pullLatest() noexcept { return coefficients.pull(); }
+    const ChainCoefficients& getLatest() const noexcept { return coefficients.getReadBuffer(); }
+
+    // =======Message thread=======
+    // Second handoff for the editor's response curve, only published when an EQ stage changes.
+    // Single reader; getDisplayed() keeps returning the last set after a failed pull.
+    bool pullDisplayed() noexcept { return displayedCoefficients.pull(); }
+    const ChainCoefficients& getDisplayed() const noexcept { return displayedCoefficients.getReadBuffer(); }
+
+private:
+    void run() override;
+
+    // Designs the requested stages into `current` and publishes it. Caller holds designLock.
+    void designAndPublish(uint32_t stages, const ChainSettings& chainSettings, uint32_t generation);
+
+    // Reads the parameters, unless a batch is in progress or starts while reading them
+    bool loadOutsideBatch(ChainSettings& chainSettings, uint32_t& generation) const noexcept;
+    void countRedesigns(int numRedesigns);
+
+    static void copyCoefficients(BiquadCoefficients& dest, const juce::dsp::IIR::Coefficients<float>& source);
+    static double getFreeverbTailSeconds(float roomSize, float damping, float decibels);
+
+    ParameterHandles parameters;
+    bool runsInline{ false };
+
+    // Serialises prepare() against the designer thread; never taken on the audio thread
+    juce::CriticalSection designLock;
+    double sampleRate{ 44100.0 };
+
+    // Cut filter designs for sampleRate, so automating a cut-off doesn't run FilterDesign each time
+    std::shared_ptr<const ButterworthTable> cutTable;
+    ChainCoefficients current;
+
+    TripleBuffer<ChainCoefficients> coefficients;
+    TripleBuffer<ChainCoefficients> displayedCoefficients;
+    std::atomic<uint32_t> dirtyStages{ 0 };
+
+    std::atomic<int> batchesInProgress{ 0 };
+    std::atomic<uint32_t> batchGeneration{ 0 };
+
+    static constexpr int pollIntervalMs = 10;
+
+    int redesignsInWindow{ 0 };
+    juce::uint32 windowStart{ 0 };
+    std::atomic<int> redesignsPerSecond{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CoefficientDesigner)
+};
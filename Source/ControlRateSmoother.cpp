@@ -0,0 +1,133 @@
+/*
+  ==============================================================================
+
+    ControlRateSmoother.cpp
+
+  ==============================================================================
+*/
+
+#include "ControlRateSmoother.h"
+
+void ControlRateSmoother::prepare(double sampleRateToUse, std::shared_ptr<const ButterworthTable> table)
+{
+    sampleRate = sampleRateToUse;
+    cutTable = std::move(table);
+
+    for (auto* value : { &lowCutFrequency, &highCutFrequency, &peakFrequency, &peakQuality })
+        value->reset(sampleRate, smoothingSeconds);
+
+    peakGainInDecibels.reset(sampleRate, smoothingSeconds);
+
+    hasTarget = false;
+    current = target;
+}
+
+void ControlRateSmoother::reset() noexcept
+{
+    for (auto* value : { &lowCutFrequency, &highCutFrequency, &peakFrequency, &peakQuality })
+        value->setCurrentAndTargetValue(value->getTargetValue());
+
+    peakGainInDecibels.setCurrentAndTargetValue(peakGainInDecibels.getTargetValue());
+
+    current = target;
+}
+
+bool ControlRateSmoother::isSmoothing() const noexcept
+{
+    return lowCutFrequency.isSmoothing() || highCutFrequency.isSmoothing()
+        || peakFrequency.isSmoothing() || peakGainInDecibels.isSmoothing() || peakQuality.isSmoothing();
+}
+
+//==============================================================================
+void ControlRateSmoother::setTarget(const ChainCoefficients& newTarget, bool jump) noexcept
+{
+    jump = jump || ! hasTarget;
+    hasTarget = true;
+    target = newTarget;
+
+    setTarget(lowCutFrequency, target.lowCutFrequency, jump || ! target.lowCutActive);
+    setTarget(highCutFrequency, target.highCutFrequency, jump || ! target.highCutActive);
+
+    auto jumpPeak = jump || ! target.peakActive;
+    setTarget(peakFrequency, target.peakFrequency, jumpPeak);
+    setTarget(peakGainInDecibels, target.peakGainInDecibels, jumpPeak);
+    setTarget(peakQuality, juce::jmax(0.01f, target.peakQuality), jumpPeak);
+
+    current = target;
+
+    if (isSmoothing())
+        designCurrent();
+}
+
+void ControlRateSmoother::advance(int numSamples) noexcept
+{
+    for (auto* value : { &lowCutFrequency, &highCutFrequency, &peakFrequency, &peakQuality })
+        value->skip(numSamples);
+
+    peakGainInDecibels.skip(numSamples);
+
+    // Arrived: back to the designer's exact coefficients
+    if (isSmoothing())
+        designCurrent();
+    else
+        current = target;
+}
+
+void ControlRateSmoother::designCurrent() noexcept
+{
+    // Stages that have arrived, and cut-offs outside the table, use the target's exact sections
+    current.lowCut = target.lowCut;
+    current.highCut = target.highCut;
+    current.peak = target.peak;
+
+    if (cutTable != nullptr)
+    {
+        if (lowCutFrequency.isSmoothing())
+            cutTable->getHighpass(lowCutFrequency.getCurrentValue(), target.lowCutSlope, current.lowCut.data());
+
+        if (highCutFrequency.isSmoothing())
+            cutTable->getLowpass(highCutFrequency.getCurrentValue(), target.highCutSlope, current.highCut.data());
+    }
+
+    if (peakFrequency.isSmoothing() || peakGainInDecibels.isSmoothing() || peakQuality.isSmoothing())
+    {
+        // makePeakFilter, without allocating the coefficients object
+        auto frequency = juce::jmin((double) peakFrequency.getCurrentValue(), sampleRate * 0.49);
+        auto amplitude = std::pow(10.0, peakGainInDecibels.getCurrentValue() / 40.0);
+        auto omega = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+        auto alpha = std::sin(omega) / (2.0 * peakQuality.getCurrentValue());
+        auto c2 = -2.0 * std::cos(omega);
+        auto a0 = 1.0 + alpha / amplitude;
+
+        current.peak = { (float) ((1.0 + alpha * amplitude) / a0), (float) (c2 / a0), (float) ((1.0 - alpha * amplitude) / a0),
+                         (float) (c2 / a0), (float) ((1.0 - alpha / amplitude) / a0) };
+    }
+}
+
+//==============================================================================
+void ControlRateSmoother::process(MultichannelFilterChain& chain, const juce::dsp::ProcessContextReplacing<float>& context) noexcept
+{
+    if (! isSmoothing())
+    {
+        chain.process(context);
+        return;
+    }
+
+    const auto& block = context.getOutputBlock();
+    auto numSamples = block.getNumSamples();
+
+    for (size_t start = 0; start < numSamples;)
+    {
+        auto controlBlock = block.getSubBlock(start, juce::jmin((size_t) controlBlockSize, numSamples - start));
+        chain.process(juce::dsp::ProcessContextReplacing<float>(controlBlock));
+
+        start += controlBlock.getNumSamples();
+
+        // Settings at the end of this control block drive the next one
+        if (isSmoothing())
+        {
+            advance((int) controlBlock.getNumSamples());
+            chain.setCoefficients(current);
+        }
+    }
+}
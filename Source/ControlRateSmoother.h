@@ -0,0 +1,90 @@
+/*
+  ==============================================================================
+
+    ControlRateSmoother.h
+
+    Glides the biquad chain to new EQ settings at a fixed control rate
+    instead of once per host block. While a cut-off, the peak gain or the
+    peak quality is still moving, the block is split into sub-blocks of
+    getControlBlockSize() samples and the chain gets fresh coefficients
+    before each one, so the update rate no longer depends on the host's
+    buffer size. Frequencies and Q glide in the log domain, the gain in dB.
+
+    The cuts are read from the shared ButterworthTable and the peak uses
+    the makePeakFilter formula directly, so nothing allocates on the audio
+    thread. Once every glide has arrived the chain runs whole blocks on the
+    designer's exact coefficients again.
+
+    SIMPLEPLUGIN_CONTROL_BLOCK_SIZE sets the default control block size;
+    the processor's setControlBlockSize() changes it at runtime.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ButterworthTable.h"
+#include "CoefficientDesigner.h"
+#include "MultichannelFilterChain.h"
+
+#ifndef SIMPLEPLUGIN_CONTROL_BLOCK_SIZE
+ #define SIMPLEPLUGIN_CONTROL_BLOCK_SIZE 32
+#endif
+
+class ControlRateSmoother
+{
+public:
+    ControlRateSmoother() = default;
+
+    // Message thread; cutTable may be null, the cuts then switch at the end of a glide
+    void prepare(double sampleRate, std::shared_ptr<const ButterworthTable> cutTable);
+
+    // Jumps every setting to its target
+    void reset() noexcept;
+
+    // Settings to glide to over smoothingSeconds. With jump set, or for the first set after prepare(),
+    // they apply at once. Stages the new set leaves inactive jump as well, since they can't be heard.
+    void setTarget(const ChainCoefficients& target, bool jump = false) noexcept;
+
+    // Coefficients for the settings reached so far, with the structure and activity of the target
+    const ChainCoefficients& getCoefficients() const noexcept { return current; }
+
+    bool isSmoothing() const noexcept;
+
+    // Runs chain over the block; in control blocks, each with fresh coefficients, while a setting glides
+    void process(MultichannelFilterChain& chain, const juce::dsp::ProcessContextReplacing<float>& context) noexcept;
+
+    // Samples between coefficient updates; smaller is smoother and costs more
+    void setControlBlockSize(int numSamples) noexcept { controlBlockSize = juce::jmax(1, numSamples); }
+    int getControlBlockSize() const noexcept { return controlBlockSize; }
+
+    static constexpr double smoothingSeconds = 0.05;
+
+private:
+    // Moves every setting on by numSamples and redesigns the EQ coefficients for where they are
+    void advance(int numSamples) noexcept;
+    void designCurrent() noexcept;
+
+    template <typename Smoothed>
+    static void setTarget(Smoothed& value, float targetValue, bool jump) noexcept
+    {
+        if (jump)
+            value.setCurrentAndTargetValue(targetValue);
+        else
+            value.setTargetValue(targetValue);
+    }
+
+    std::shared_ptr<const ButterworthTable> cutTable;
+    double sampleRate{ 44100.0 };
+
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative> lowCutFrequency, highCutFrequency, peakFrequency, peakQuality;
+    juce::SmoothedValue<float> peakGainInDecibels;
+
+    ChainCoefficients target, current;
+    bool hasTarget{ false };
+
+    int controlBlockSize{ SIMPLEPLUGIN_CONTROL_BLOCK_SIZE };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ControlRateSmoother)
+};
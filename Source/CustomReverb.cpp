@@ -0,0 +1,315 @@
+/*
+  ==============================================================================
+
+    CustomReverb.cpp
+
+  ==============================================================================
+*/
+
+#include "CustomReverb.h"
+
+namespace
+{
+    constexpr float inputGain = 0.25f;
+    constexpr float outputGain = 0.35355339f; // 1 / sqrt(numLines)
+    constexpr float butterflyGain = 0.70710678f;
+
+    // Decay time in seconds for roomSize 0..1
+    float getDecayTime(float roomSize)
+    {
+        return 0.3f * std::pow(25.0f, roomSize);
+    }
+
+    // Eight mutually orthogonal tap patterns, starting with the stereo pair's left and right
+    constexpr std::array<std::array<float, 8>, 8> tapPatterns
+    {{
+        { 1,  1, -1, -1,  1, -1,  1, -1 },
+        { 1, -1, -1,  1, -1,  1,  1, -1 },
+        { 1,  1,  1,  1, -1, -1, -1, -1 },
+        { 1,  1, -1, -1, -1,  1, -1,  1 },
+        { 1, -1,  1, -1,  1,  1, -1, -1 },
+        { 1, -1,  1, -1, -1, -1,  1,  1 },
+        { 1, -1, -1,  1,  1, -1, -1,  1 },
+        { 1,  1,  1,  1,  1,  1,  1,  1 }
+    }};
+
+    // Every further set of eight channels flips the signs of some lines. These masks keep the
+    // normalised correlation between any two of the first 64 channels at 0.5 or less.
+    constexpr std::array<std::array<float, 8>, 8> setSigns
+    {{
+        { 1, 1, 1,  1, 1,  1,  1,  1 },
+        { 1, 1, 1,  1, 1,  1, -1, -1 },
+        { 1, 1, 1,  1, 1, -1,  1, -1 },
+        { 1, 1, 1,  1, 1, -1, -1,  1 },
+        { 1, 1, 1, -1, 1,  1,  1, -1 },
+        { 1, 1, 1, -1, 1,  1, -1,  1 },
+        { 1, 1, 1, -1, 1, -1,  1,  1 },
+        { 1, 1, 1, -1, 1, -1, -1, -1 }
+    }};
+
+    std::array<float, 8> getOutputTaps(int channel)
+    {
+        const auto& pattern = tapPatterns[(size_t) (channel % 8)];
+        const auto& signs = setSigns[(size_t) ((channel / 8) % 8)];
+
+        std::array<float, 8> taps;
+
+        for (size_t k = 0; k < taps.size(); ++k)
+            taps[k] = pattern[k] * signs[k];
+
+        return taps;
+    }
+}
+
+CustomReverb::CustomReverb()
+{
+    alignas(Vector::SIMDRegisterSize) const std::array<float, numLines> input{ 1, -1, 1, -1, 1, 1, -1, -1 };
+
+    for (int v = 0; v < numVectors; ++v)
+        inputSigns[(size_t) v] = load(input.data() + v * lanesPerVector);
+
+    dampingCoefficient = Vector::expand(0.0f);
+    modulationDepth = Vector::expand(0.0f);
+}
+
+CustomReverb::~CustomReverb()
+{
+}
+
+void CustomReverb::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    sampleRate = spec.sampleRate;
+
+    static_assert(numLines == 8, "The output tap patterns are written for eight lines");
+
+    outputSigns.resize(spec.numChannels);
+    channels.resize(spec.numChannels);
+
+    for (int channel = 0; channel < (int) spec.numChannels; ++channel)
+    {
+        alignas(Vector::SIMDRegisterSize) auto taps = getOutputTaps(channel);
+
+        for (int v = 0; v < numVectors; ++v)
+            outputSigns[(size_t) channel][(size_t) v] = load(taps.data() + v * lanesPerVector);
+    }
+
+    auto maxModulation = modulationDepthSeconds * (float) sampleRate;
+    auto longestDelay = 0;
+
+    for (size_t k = 0; k < (size_t) numLines; ++k)
+    {
+        delays[k] = (float) (baseDelays[k] * sampleRate / baseSampleRate);
+        longestDelay = juce::jmax(longestDelay, (int) std::ceil(delays[k] + maxModulation) + 2);
+    }
+
+    // Power-of-two lines allow masked indexing and keep every line cache-line aligned within the arena
+    lineSize = juce::jmax(cacheLineFloats, juce::nextPowerOfTwo(longestDelay));
+    lineMask = lineSize - 1;
+
+    arena.assign((size_t) (lineSize * numLines + cacheLineFloats), 0.0f);
+
+    auto misalignment = (int) ((reinterpret_cast<std::uintptr_t>(arena.data()) / sizeof(float)) % (std::uintptr_t) cacheLineFloats);
+    lines = arena.data() + (misalignment == 0 ? 0 : cacheLineFloats - misalignment);
+
+    modulationIncrement = juce::MathConstants<double>::twoPi * modulationRateHz / sampleRate;
+    modulationRotationCos = Vector::expand((float) std::cos(modulationIncrement));
+    modulationRotationSin = Vector::expand((float) std::sin(modulationIncrement));
+    modulationDepth = Vector::expand(maxModulation);
+
+    wetGain.reset(sampleRate, 0.05);
+    dryGain.reset(sampleRate, 0.05);
+
+    updateDecay();
+    reset();
+}
+
+void CustomReverb::reset()
+{
+    std::fill(arena.begin(), arena.end(), 0.0f);
+    writePosition = 0;
+
+    for (auto& state : dampingStates)
+        state = Vector::expand(0.0f);
+
+    // Spread the modulation phases evenly over the lines
+    for (size_t k = 0; k < (size_t) numLines; ++k)
+        modulationPhases[k] = juce::MathConstants<double>::twoPi * (double) k / numLines;
+}
+
+void CustomReverb::setParameters(float newRoomSize, float newDamping, float wetLevel, float dryLevel)
+{
+    roomSize = newRoomSize;
+    damping = newDamping;
+
+    wetGain.setTargetValue(wetLevel);
+    dryGain.setTargetValue(dryLevel);
+
+    updateDecay();
+}
+
+double CustomReverb::getTailSeconds(float roomSize, float damping, float decibels)
+{
+    // The damping lowpass has unity gain at DC, so it only shortens the highs; its group delay at DC
+    // stretches every trip round a line, most of all round the shortest one
+    auto dampingCoefficient = (double) damping * 0.8;
+    auto dampingDelay = dampingCoefficient / (1.0 - dampingCoefficient);
+    auto stretch = 1.0 + dampingDelay / (double) baseDelays[0];
+
+    return (double) getDecayTime(roomSize) * (double) decibels / -60.0 * stretch;
+}
+
+void CustomReverb::updateDecay()
+{
+    auto decaySamples = getDecayTime(roomSize) * (float) sampleRate;
+
+    // Per-line gain for -60 dB after the decay time, independent of the line length
+    alignas(Vector::SIMDRegisterSize) std::array<float, numLines> gains;
+
+    for (size_t k = 0; k < (size_t) numLines; ++k)
+        gains[k] = std::pow(10.0f, -3.0f * delays[k] / decaySamples);
+
+    for (int v = 0; v < numVectors; ++v)
+        decayGains[(size_t) v] = load(gains.data() + v * lanesPerVector);
+
+    dampingCoefficient = Vector::expand(damping * 0.8f);
+}
+
+void CustomReverb::seedModulation()
+{
+    alignas(Vector::SIMDRegisterSize) std::array<float, numLines> cosines, sines;
+
+    for (size_t k = 0; k < (size_t) numLines; ++k)
+    {
+        cosines[k] = (float) std::cos(modulationPhases[k]);
+        sines[k] = (float) std::sin(modulationPhases[k]);
+    }
+
+    for (int v = 0; v < numVectors; ++v)
+    {
+        modulationCos[(size_t) v] = load(cosines.data() + v * lanesPerVector);
+        modulationSin[(size_t) v] = load(sines.data() + v * lanesPerVector);
+    }
+}
+
+//==============================================================================
+void CustomReverb::process(const juce::dsp::ProcessContextReplacing<float>& context) noexcept
+{
+    auto& block = context.getOutputBlock();
+    auto numChannels = juce::jmin(block.getNumChannels(), channels.size());
+    auto numSamples = block.getNumSamples();
+
+    // More channels than were prepared for have no output taps
+    jassert(block.getNumChannels() <= channels.size());
+
+    if (context.isBypassed || numChannels == 0 || lines == nullptr)
+        return;
+
+    for (size_t channel = 0; channel < numChannels; ++channel)
+        channels[channel] = block.getChannelPointer(channel);
+
+    auto inputScale = 1.0f / (float) numChannels;
+
+    seedModulation();
+
+    alignas(Vector::SIMDRegisterSize) std::array<float, numLines> lanes;
+    alignas(Vector::SIMDRegisterSize) std::array<float, numLines> offsets;
+    std::array<Vector, numVectors> x;
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        auto input = 0.0f;
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+            input += channels[channel][i];
+
+        // Advance the modulation phasors and read every line at its modulated position
+        for (int v = 0; v < numVectors; ++v)
+        {
+            auto c = modulationCos[(size_t) v];
+            auto s = modulationSin[(size_t) v];
+
+            modulationCos[(size_t) v] = c * modulationRotationCos - s * modulationRotationSin;
+            modulationSin[(size_t) v] = s * modulationRotationCos + c * modulationRotationSin;
+
+            (modulationSin[(size_t) v] * modulationDepth).copyToRawArray(offsets.data() + v * lanesPerVector);
+        }
+
+        for (size_t k = 0; k < (size_t) numLines; ++k)
+            lanes[k] = readLine((int) k, delays[k] + offsets[k]);
+
+        // Damping lowpass and decay per line
+        for (int v = 0; v < numVectors; ++v)
+        {
+            auto lineOutputs = load(lanes.data() + v * lanesPerVector);
+            auto& state = dampingStates[(size_t) v];
+
+            state = lineOutputs + (state - lineOutputs) * dampingCoefficient;
+            x[(size_t) v] = state * decayGains[(size_t) v];
+        }
+
+        // Every channel taps the lines before the feedback matrix
+        auto wet = wetGain.getNextValue() * outputGain;
+        auto dry = dryGain.getNextValue();
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            const auto& signs = outputSigns[channel];
+            auto output = Vector::expand(0.0f);
+
+            for (int v = 0; v < numVectors; ++v)
+                output += x[(size_t) v] * signs[(size_t) v];
+
+            channels[channel][i] = dry * channels[channel][i] + wet * output.sum();
+        }
+
+        // Feedback matrix: butterfly across the registers, then a Householder reflection over all lines
+        if constexpr (numVectors == 2)
+        {
+            auto sum = (x[0] + x[1]) * Vector::expand(butterflyGain);
+            auto difference = (x[0] - x[1]) * Vector::expand(butterflyGain);
+
+            x[0] = sum;
+            x[1] = difference;
+        }
+
+        auto lineSum = 0.0f;
+
+        for (auto& vector : x)
+            lineSum += vector.sum();
+
+        auto reflection = Vector::expand(lineSum * (2.0f / numLines));
+        auto feed = Vector::expand(input * inputScale * inputGain);
+
+        for (int v = 0; v < numVectors; ++v)
+        {
+            x[(size_t) v] = x[(size_t) v] - reflection + inputSigns[(size_t) v] * feed;
+            x[(size_t) v].copyToRawArray(lanes.data() + v * lanesPerVector);
+        }
+
+        for (size_t k = 0; k < (size_t) numLines; ++k)
+            lines[(int) k * lineSize + writePosition] = lanes[k];
+
+        writePosition = (writePosition + 1) & lineMask;
+    }
+
+    for (auto& phase : modulationPhases)
+        phase = std::fmod(phase + modulationIncrement * (double) numSamples, juce::MathConstants<double>::twoPi);
+}
+
+float CustomReverb::readLine(int line, float delayInSamples) const noexcept
+{
+    auto readPosition = (float) writePosition - delayInSamples;
+    auto integerPart = (int) std::floor(readPosition);
+    auto fraction = readPosition - (float) integerPart;
+
+    const auto* data = lines + line * lineSize;
+    auto a = data[integerPart & lineMask];
+    auto b = data[(integerPart + 1) & lineMask];
+
+    return a + fraction * (b - a);
+}
+
+CustomReverb::Vector CustomReverb::load(const float* lanes) noexcept
+{
+    return Vector::fromRawArray(lanes);
+}
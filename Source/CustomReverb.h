@@ -0,0 +1,107 @@
+/*
+  ==============================================================================
+
+    CustomReverb.h
+
+    Eight line feedback delay network reverb, the FDN engine.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Eight line feedback delay network reverb.
+
+    The eight lines are held as two SIMD registers of four lanes each. The
+    feedback matrix is a butterfly between the two registers followed by a
+    Householder reflection, which is orthogonal, so the network is lossless
+    apart from the per-line decay gains and damping filters. All delay lines
+    share one contiguous, cache-line aligned arena, and their read positions
+    are slowly modulated to avoid metallic ringing.
+
+    The input is the average of all channels. Every output channel taps the
+    lines with its own sign pattern, so any number of channels gets its own
+    reverb from the same network. With eight lines, up to eight channels
+    are fully decorrelated; further channels are correlated with any other
+    by about one half at most.
+*/
+class CustomReverb
+{
+public:
+    CustomReverb();
+    ~CustomReverb();
+
+    // Allocates the delay arena for spec.sampleRate and the output taps for spec.numChannels
+    void prepare(const juce::dsp::ProcessSpec& spec);
+    void reset();
+
+    void setParameters(float roomSize, float damping, float wetLevel, float dryLevel);
+
+    // Time for the tail to fall the given number of decibels (negative) below the input
+    static double getTailSeconds(float roomSize, float damping, float decibels);
+
+    // Processes up to the prepared number of channels in place; never allocates
+    void process(const juce::dsp::ProcessContextReplacing<float>& context) noexcept;
+
+private:
+    using Vector = juce::dsp::SIMDRegister<float>;
+
+    static constexpr int numLines = 8;
+    static constexpr int lanesPerVector = (int) Vector::SIMDNumElements;
+    static constexpr int numVectors = numLines / lanesPerVector;
+
+    static_assert(numLines % lanesPerVector == 0, "The lines have to fill whole SIMD registers");
+
+    // Mutually prime line lengths in samples at 48 kHz, scaled to the actual sample rate
+    static constexpr std::array<int, numLines> baseDelays{ 1031, 1327, 1523, 1871, 2053, 2311, 2539, 2803 };
+    static constexpr double baseSampleRate = 48000.0;
+
+    static constexpr float modulationDepthSeconds = 0.0002f;
+    static constexpr float modulationRateHz = 0.7f;
+
+    static constexpr int cacheLineFloats = 64 / (int) sizeof(float);
+
+    void updateDecay();
+    void seedModulation();
+    float readLine(int line, float delayInSamples) const noexcept;
+
+    static Vector load(const float* lanes) noexcept;
+
+    double sampleRate{ 44100.0 };
+
+    // One power-of-two region per line inside a single allocation
+    std::vector<float> arena;
+    float* lines{ nullptr };
+    int lineSize{ 0 };
+    int lineMask{ 0 };
+    int writePosition{ 0 };
+
+    std::array<float, numLines> delays{};
+
+    // Per-line state, as SIMD registers
+    std::array<Vector, numVectors> decayGains, dampingStates;
+    std::array<Vector, numVectors> modulationCos, modulationSin;
+    Vector modulationRotationCos, modulationRotationSin, modulationDepth;
+
+    // Reseeds the modulation phasors once per block so they can't drift in amplitude
+    std::array<double, numLines> modulationPhases{};
+    double modulationIncrement{ 0.0 };
+    Vector dampingCoefficient;
+
+    // Sign patterns that spread the input over the lines and decorrelate the outputs, one per channel
+    std::array<Vector, numVectors> inputSigns;
+    std::vector<std::array<Vector, numVectors>> outputSigns;
+    std::vector<float*> channels;
+
+    float roomSize{ 0.5f };
+    float damping{ 0.5f };
+
+    juce::SmoothedValue<float> wetGain, dryGain;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CustomReverb)
+};
@@ -0,0 +1,241 @@
+/*
+  ==============================================================================
+
+    MultichannelFilterChain.cpp
+
+  ==============================================================================
+*/
+
+#include "MultichannelFilterChain.h"
+
+const std::array<MultichannelFilterChain::ChainFunction, MultichannelFilterChain::numChainVariants> MultichannelFilterChain::chainFunctions
+    = MultichannelFilterChain::makeChainFunctions(std::make_index_sequence<MultichannelFilterChain::numChainVariants>());
+
+MultichannelFilterChain::MultichannelFilterChain()
+{
+    for (int slot = 0; slot < numSlots; ++slot)
+        setSection(slot, {});
+}
+
+void MultichannelFilterChain::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    auto numGroups = ((int) spec.numChannels + channelsPerGroup - 1) / channelsPerGroup;
+    groupStates.resize((size_t) numGroups);
+    fadeStates.resize((size_t) numGroups);
+    frames.resize(juce::jmax((size_t) 1, (size_t) spec.maximumBlockSize));
+
+    fadeBuffer.setSize((int) spec.numChannels, (int) spec.maximumBlockSize);
+    fadeLength = juce::jmax(1, juce::roundToInt(crossfadeSeconds * spec.sampleRate));
+
+    reset();
+}
+
+void MultichannelFilterChain::reset() noexcept
+{
+    for (int slot = 0; slot < numSlots; ++slot)
+        resetSlot(slot);
+
+    fadePosition = fadeLength;
+    hasPendingCoefficients = false;
+    hasProcessed = false;
+}
+
+void MultichannelFilterChain::resetSlot(int slot) noexcept
+{
+    for (auto& states : groupStates)
+        states[(size_t) slot] = { Vector::expand(0.0f), Vector::expand(0.0f) };
+}
+
+uint32_t MultichannelFilterChain::getSlotMask(int variantToDecode) noexcept
+{
+    auto numLowCut = variantToDecode / (2 * numCutVariants);
+    auto numPeak = (variantToDecode / numCutVariants) % 2;
+    auto numHighCut = variantToDecode % numCutVariants;
+
+    return (((1u << numLowCut) - 1u) << firstLowCutSlot)
+         | ((uint32_t) numPeak << peakSlot)
+         | (((1u << numHighCut) - 1u) << firstHighCutSlot);
+}
+
+//==============================================================================
+int MultichannelFilterChain::getVariant(const ChainCoefficients& chainCoefficients) noexcept
+{
+    return getVariant(chainCoefficients.lowCutActive ? chainCoefficients.lowCutSlope + 1 : 0,
+                      chainCoefficients.peakActive ? 1 : 0,
+                      chainCoefficients.highCutActive ? chainCoefficients.highCutSlope + 1 : 0);
+}
+
+void MultichannelFilterChain::setCoefficients(const ChainCoefficients& chainCoefficients, bool crossfade) noexcept
+{
+    auto startsFade = hasProcessed && (crossfade || getVariant(chainCoefficients) != variant);
+
+    // Starting another fade now would drop the configuration that is fading out mid-ramp. Whatever
+    // arrives from here on waits until the running fade ends, the latest set replacing earlier ones.
+    if (hasPendingCoefficients || (startsFade && fadePosition < fadeLength))
+    {
+        pendingCrossfade = (hasPendingCoefficients && pendingCrossfade) || crossfade;
+        pendingCoefficients = chainCoefficients;
+        hasPendingCoefficients = true;
+        return;
+    }
+
+    applyCoefficients(chainCoefficients, crossfade);
+}
+
+void MultichannelFilterChain::applyCoefficients(const ChainCoefficients& chainCoefficients, bool crossfade) noexcept
+{
+    auto newVariant = getVariant(chainCoefficients);
+
+    // The running configuration fades out with its coefficients, on a copy of its state
+    if (hasProcessed && (crossfade || newVariant != variant))
+    {
+        fadeSections = sections;
+        std::copy(groupStates.begin(), groupStates.end(), fadeStates.begin());
+        fadeVariant = variant;
+        fadePosition = 0;
+    }
+
+    for (int i = 0; i < ChainCoefficients::maxCutSections; ++i)
+    {
+        setSection(firstLowCutSlot + i, chainCoefficients.lowCut[(size_t) i]);
+        setSection(firstHighCutSlot + i, chainCoefficients.highCut[(size_t) i]);
+    }
+
+    setSection(peakSlot, chainCoefficients.peak);
+
+    // Sections that join have stale state, start them from silence instead
+    auto joiningSlots = getSlotMask(newVariant) & ~getSlotMask(variant);
+
+    for (int slot = 0; slot < numSlots; ++slot)
+        if (joiningSlots & (1u << slot))
+            resetSlot(slot);
+
+    variant = newVariant;
+}
+
+void MultichannelFilterChain::setSection(int slot, const BiquadCoefficients& coefficients) noexcept
+{
+    auto& section = sections[(size_t) slot];
+    section.b0 = Vector::expand(coefficients.b0);
+    section.b1 = Vector::expand(coefficients.b1);
+    section.b2 = Vector::expand(coefficients.b2);
+    section.a1 = Vector::expand(coefficients.a1);
+    section.a2 = Vector::expand(coefficients.a2);
+}
+
+//==============================================================================
+void MultichannelFilterChain::process(const juce::dsp::ProcessContextReplacing<float>& context) noexcept
+{
+    if (context.isBypassed)
+        return;
+
+    auto& block = context.getOutputBlock();
+    hasProcessed = true;
+
+    if (fadePosition >= fadeLength)
+    {
+        runVariant(variant, block, sections.data(), groupStates);
+        return;
+    }
+
+    auto numChannels = juce::jmin(block.getNumChannels(), (size_t) fadeBuffer.getNumChannels());
+    auto numSamples = block.getNumSamples();
+
+    // Hosts may send more samples than prepareToPlay announced
+    auto maxChunkSize = (size_t) fadeBuffer.getNumSamples();
+
+    for (size_t start = 0; start < numSamples;)
+    {
+        // A change held back during the fade takes over as soon as the fade ends, which may start the next one
+        if (fadePosition >= fadeLength && hasPendingCoefficients)
+        {
+            hasPendingCoefficients = false;
+            applyCoefficients(pendingCoefficients, pendingCrossfade);
+        }
+
+        if (fadePosition >= fadeLength)
+        {
+            runVariant(variant, block.getSubBlock(start, numSamples - start), sections.data(), groupStates);
+            return;
+        }
+
+        // Chunks end where the fade does, so a held back change starts on the exact sample
+        auto chunkSize = juce::jmin(numSamples - start, maxChunkSize, (size_t) (fadeLength - fadePosition));
+        auto newBlock = block.getSubBlock(start, chunkSize).getSubsetChannelBlock(0, numChannels);
+
+        juce::dsp::AudioBlock<float> oldBlock(fadeBuffer.getArrayOfWritePointers(), numChannels, chunkSize);
+        oldBlock.copyFrom(newBlock);
+
+        runVariant(fadeVariant, oldBlock, fadeSections.data(), fadeStates);
+        runVariant(variant, newBlock, sections.data(), groupStates);
+
+        // Linear crossfade from the old configuration to the new one
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            auto* oldSamples = oldBlock.getChannelPointer(channel);
+            auto* newSamples = newBlock.getChannelPointer(channel);
+
+            for (size_t i = 0; i < chunkSize; ++i)
+            {
+                auto gain = juce::jmin(1.0f, (float) (fadePosition + (int) i) / (float) fadeLength);
+                newSamples[i] = oldSamples[i] + gain * (newSamples[i] - oldSamples[i]);
+            }
+        }
+
+        fadePosition = juce::jmin(fadeLength, fadePosition + (int) chunkSize);
+        start += chunkSize;
+    }
+}
+
+void MultichannelFilterChain::runVariant(int variantToRun, const juce::dsp::AudioBlock<float>& block, const Section* slotSections, std::vector<GroupState>& states) noexcept
+{
+    auto numChannels = (int) block.getNumChannels();
+
+    // More channels than were prepared for have no filter state
+    jassert(numChannels <= (int) states.size() * channelsPerGroup);
+    numChannels = juce::jmin(numChannels, (int) states.size() * channelsPerGroup);
+
+    // Every stage transparent or bypassed: the block passes through untouched
+    if (numChannels == 0 || variantToRun == getVariant(0, 0, 0))
+        return;
+
+    // One dispatch per block into the instantiation for the running sections
+    auto chainFunction = chainFunctions[(size_t) variantToRun];
+
+    // Hosts may send more samples than prepareToPlay announced
+    auto maxChunkSize = frames.size();
+    auto* frameSamples = reinterpret_cast<float*>(frames.data());
+
+    for (int firstChannel = 0, group = 0; firstChannel < numChannels; firstChannel += channelsPerGroup, ++group)
+    {
+        auto numLanes = juce::jmin(channelsPerGroup, numChannels - firstChannel);
+
+        for (size_t start = 0; start < block.getNumSamples(); start += maxChunkSize)
+        {
+            auto numSamples = juce::jmin(maxChunkSize, block.getNumSamples() - start);
+
+            for (int lane = 0; lane < numLanes; ++lane)
+            {
+                const auto* samples = block.getChannelPointer((size_t) (firstChannel + lane)) + start;
+
+                for (size_t i = 0; i < numSamples; ++i)
+                    frameSamples[i * channelsPerGroup + (size_t) lane] = samples[i];
+            }
+
+            // Spare lanes hold silence, so their state stays at zero
+            for (int lane = numLanes; lane < channelsPerGroup; ++lane)
+                for (size_t i = 0; i < numSamples; ++i)
+                    frameSamples[i * channelsPerGroup + (size_t) lane] = 0.0f;
+
+            chainFunction(frames.data(), numSamples, slotSections, states[(size_t) group].data());
+
+            for (int lane = 0; lane < numLanes; ++lane)
+            {
+                auto* samples = block.getChannelPointer((size_t) (firstChannel + lane)) + start;
+
+                for (size_t i = 0; i < numSamples; ++i)
+                    samples[i] = frameSamples[i * channelsPerGroup + (size_t) lane];
+            }
+        }
+    }
+}
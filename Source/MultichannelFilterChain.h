@@ -0,0 +1,207 @@
+/*
+  ==============================================================================
+
+    MultichannelFilterChain.h
+
+    Low cut, peak and high cut biquads for any number of channels. Every
+    channel shares the same coefficients, so the channels are packed into
+    the lanes of a SIMDRegister, one group of lanes at a time. Each group
+    is interleaved once per block into an aligned buffer of registers, every
+    frame runs through every active section in place, and the result is
+    split back into the channels. Spare lanes of a group that isn't full
+    stay silent.
+
+    Stages the designer marks inactive (bypassed or transparent) are left
+    out of the pass entirely. Whenever the set of running sections changes,
+    or a caller asks for it on a preset switch, the previous coefficients
+    keep running on a copy of the filter state for a short crossfade, and
+    sections that join start from silence.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "CoefficientDesigner.h"
+
+class MultichannelFilterChain
+{
+public:
+    using Vector = juce::dsp::SIMDRegister<float>;
+
+    // Channels that share one pass through the chain
+    static constexpr int channelsPerGroup = (int) Vector::SIMDNumElements;
+
+    MultichannelFilterChain();
+
+    // Allocates the filter state, the interleaved frames and the crossfade buffer for spec.numChannels
+    void prepare(const juce::dsp::ProcessSpec& spec);
+    void reset() noexcept;
+
+    // Broadcasts the coefficients into the SIMD lanes; never allocates. With crossfade set the old
+    // coefficients fade out even if the same sections keep running, for jumps such as a preset switch.
+    // A change that needs a fade while one is running is held back until that fade has finished.
+    void setCoefficients(const ChainCoefficients& chainCoefficients, bool crossfade = false) noexcept;
+
+    // Processes up to the prepared number of channels in place, in one pass over the block per group.
+    // Returns straight away while every stage is inactive.
+    void process(const juce::dsp::ProcessContextReplacing<float>& context) noexcept;
+
+    static constexpr double crossfadeSeconds = 0.01;
+
+    // Passes over the samples per block outside a crossfade: interleaving into the frames,
+    // the cascade over the frames, and splitting them back into the channels
+    static constexpr int getMemoryPassesPerBlock() noexcept { return 3; }
+
+private:
+    // Fixed slots so each section keeps its state when the slopes change
+    enum Slots
+    {
+        firstLowCutSlot = 0,
+        peakSlot = ChainCoefficients::maxCutSections,
+        firstHighCutSlot = peakSlot + 1,
+        numSlots = firstHighCutSlot + ChainCoefficients::maxCutSections
+    };
+
+    struct Section
+    {
+        Vector b0, b1, b2, a1, a2;
+    };
+
+    struct State
+    {
+        Vector s1, s2;
+    };
+
+    using GroupState = std::array<State, numSlots>;
+
+    void setSection(int slot, const BiquadCoefficients& coefficients) noexcept;
+
+    // One transposed direct form II section for one packed frame
+    static Vector tick(Vector input, const Section& section, State& state) noexcept
+    {
+        auto output = section.b0 * input + state.s1;
+
+        state.s1 = section.b1 * input - section.a1 * output + state.s2;
+        state.s2 = section.b2 * input - section.a2 * output;
+
+        return output;
+    }
+
+    template <size_t... SectionIndices>
+    static Vector tickCascade(Vector input, const Section* cascade, State* state, std::index_sequence<SectionIndices...>) noexcept
+    {
+        ((input = tick(input, cascade[SectionIndices], state[SectionIndices])), ...);
+        return input;
+    }
+
+    // Slots used by NumLowCut low cut sections, NumPeak (0 or 1) peaks and NumHighCut high cut sections, in processing order
+    template <int NumLowCut, int NumPeak, int NumHighCut>
+    static constexpr std::array<int, (size_t) (NumLowCut + NumPeak + NumHighCut)> getSlots() noexcept
+    {
+        std::array<int, (size_t) (NumLowCut + NumPeak + NumHighCut)> slots{};
+        size_t index = 0;
+
+        for (int i = 0; i < NumLowCut; ++i)
+            slots[index++] = firstLowCutSlot + i;
+
+        for (int i = 0; i < NumPeak; ++i)
+            slots[index++] = peakSlot;
+
+        for (int i = 0; i < NumHighCut; ++i)
+            slots[index++] = firstHighCutSlot + i;
+
+        return slots;
+    }
+
+    // Runs the whole chain over interleaved frames in a single pass: every frame is loaded once, goes
+    // through all sections in registers, and is stored once. Coefficients and state live in locals so
+    // the stores to the frames can't force them to be reloaded.
+    template <int NumLowCut, int NumPeak, int NumHighCut>
+    static void processChain(Vector* frames, size_t numSamples, const Section* slotSections, State* slotStates) noexcept
+    {
+        constexpr auto slots = getSlots<NumLowCut, NumPeak, NumHighCut>();
+        constexpr auto numSections = slots.size();
+
+        std::array<Section, numSections> localSections;
+        std::array<State, numSections> localStates;
+
+        for (size_t k = 0; k < numSections; ++k)
+        {
+            localSections[k] = slotSections[slots[k]];
+            localStates[k] = slotStates[slots[k]];
+        }
+
+        for (size_t i = 0; i < numSamples; ++i)
+            frames[i] = tickCascade(frames[i], localSections.data(), localStates.data(), std::make_index_sequence<numSections>());
+
+        for (size_t k = 0; k < numSections; ++k)
+            slotStates[slots[k]] = localStates[k];
+    }
+
+    using ChainFunction = void (*)(Vector*, size_t, const Section*, State*) noexcept;
+
+    // 0..maxCutSections low cut sections, with or without the peak, 0..maxCutSections high cut sections
+    static constexpr int numCutVariants = ChainCoefficients::maxCutSections + 1;
+    static constexpr int numChainVariants = numCutVariants * 2 * numCutVariants;
+
+    static constexpr int getVariant(int numLowCut, int numPeak, int numHighCut) noexcept
+    {
+        return (numLowCut * 2 + numPeak) * numCutVariants + numHighCut;
+    }
+
+    // Variant that runs the active stages of a coefficient set
+    static int getVariant(const ChainCoefficients& chainCoefficients) noexcept;
+
+    template <size_t... VariantIndices>
+    static constexpr std::array<ChainFunction, numChainVariants> makeChainFunctions(std::index_sequence<VariantIndices...>)
+    {
+        return { &processChain<(int) VariantIndices / (2 * numCutVariants),
+                               ((int) VariantIndices / numCutVariants) % 2,
+                               (int) VariantIndices % numCutVariants>... };
+    }
+
+    // One fully unrolled instantiation per combination of running sections, indexed by getVariant()
+    static const std::array<ChainFunction, numChainVariants> chainFunctions;
+
+    // Bit per slot that the variant runs
+    static uint32_t getSlotMask(int variant) noexcept;
+
+    void runVariant(int variantToRun, const juce::dsp::AudioBlock<float>& block, const Section* slotSections, std::vector<GroupState>& states) noexcept;
+
+    void resetSlot(int slot) noexcept;
+
+    // setCoefficients() once nothing is held back
+    void applyCoefficients(const ChainCoefficients& chainCoefficients, bool crossfade) noexcept;
+
+    std::array<Section, numSlots> sections;
+
+    // One set of states per group of channels
+    std::vector<GroupState> groupStates;
+
+    // One group of channels at a time, a register per sample frame
+    std::vector<Vector> frames;
+
+    int variant{ getVariant(1, 1, 1) };
+
+    // =======Crossfade=======
+    // The previous variant runs with its own coefficients, on its own copy of the state,
+    // into fadeBuffer while the new one fades in
+    std::array<Section, numSlots> fadeSections;
+    std::vector<GroupState> fadeStates;
+    juce::AudioBuffer<float> fadeBuffer;
+    int fadeVariant{ 0 };
+    int fadeLength{ 1 };
+    int fadePosition{ 0 };
+
+    // Latest change that arrived during a fade; a preset switch among the held back ones still crossfades
+    ChainCoefficients pendingCoefficients;
+    bool pendingCrossfade{ false };
+    bool hasPendingCoefficients{ false };
+
+    // Nothing was processed since the last reset, so there is no output to fade from
+    bool hasProcessed{ false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MultichannelFilterChain)
+};
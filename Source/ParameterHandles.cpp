@@ -0,0 +1,96 @@
+/*
+  ==============================================================================
+
+    ParameterHandles.cpp
+
+  ==============================================================================
+*/
+
+#include "ParameterHandles.h"
+
+namespace
+{
+    std::atomic<float>* getHandle(juce::AudioProcessorValueTreeState& apvts, const char* parameterID)
+    {
+        auto* handle = apvts.getRawParameterValue(parameterID);
+
+        // The ID has to exist in createParameterLayout
+        jassert(handle != nullptr);
+        return handle;
+    }
+
+    float loadRelaxed(const std::atomic<float>* handle) noexcept
+    {
+        return handle->load(std::memory_order_relaxed);
+    }
+
+    namespace Index
+    {
+        using ParameterIDs::indexOf;
+
+        constexpr auto lowCutFreq      = indexOf(ParameterIDs::lowCutFreq);
+        constexpr auto highCutFreq     = indexOf(ParameterIDs::highCutFreq);
+        constexpr auto peakFreq        = indexOf(ParameterIDs::peakFreq);
+        constexpr auto peakGain        = indexOf(ParameterIDs::peakGain);
+        constexpr auto peakQuality     = indexOf(ParameterIDs::peakQuality);
+        constexpr auto lowCutSlope     = indexOf(ParameterIDs::lowCutSlope);
+        constexpr auto highCutSlope    = indexOf(ParameterIDs::highCutSlope);
+        constexpr auto inputEqBypassed = indexOf(ParameterIDs::inputEqBypassed);
+        constexpr auto lowCutBypassed  = indexOf(ParameterIDs::lowCutBypassed);
+        constexpr auto peakBypassed    = indexOf(ParameterIDs::peakBypassed);
+        constexpr auto highCutBypassed = indexOf(ParameterIDs::highCutBypassed);
+        constexpr auto eqEngine        = indexOf(ParameterIDs::eqEngine);
+        constexpr auto mix             = indexOf(ParameterIDs::mix);
+        constexpr auto roomSize        = indexOf(ParameterIDs::roomSize);
+        constexpr auto damping         = indexOf(ParameterIDs::damping);
+        constexpr auto reverbEngine    = indexOf(ParameterIDs::reverbEngine);
+        constexpr auto preDelay        = indexOf(ParameterIDs::preDelay);
+        constexpr auto analyzerEnabled = indexOf(ParameterIDs::analyzerEnabled);
+    }
+}
+
+ParameterHandles::ParameterHandles(juce::AudioProcessorValueTreeState& apvts)
+{
+    for (size_t index = 0; index < handles.size(); ++index)
+        handles[index] = getHandle(apvts, ParameterIDs::all[index]);
+}
+
+ChainSettings ParameterHandles::load() const noexcept
+{
+    ParameterValues values;
+
+    for (size_t index = 0; index < handles.size(); ++index)
+        values[index] = loadRelaxed(handles[index]);
+
+    return load(values);
+}
+
+ChainSettings ParameterHandles::load(const ParameterValues& values) noexcept
+{
+    // The indices are resolved at compile time
+    ChainSettings settings;
+    settings.lowCutFreq = values[Index::lowCutFreq];
+    settings.highCutFreq = values[Index::highCutFreq];
+    settings.peakFreq = values[Index::peakFreq];
+    settings.peakGainInDecibels = values[Index::peakGain];
+    settings.peakQuality = values[Index::peakQuality];
+    settings.highCutSlope = static_cast<Slope>(values[Index::highCutSlope]);
+    settings.lowCutSlope = static_cast<Slope>(values[Index::lowCutSlope]);
+
+    settings.inputEqBypassed = values[Index::inputEqBypassed] > 0.5f;
+    settings.lowCutBypassed = values[Index::lowCutBypassed] > 0.5f;
+    settings.peakBypassed = values[Index::peakBypassed] > 0.5f;
+    settings.HighCutBypassed = values[Index::highCutBypassed] > 0.5f;
+    settings.eqEngine = static_cast<EqEngine>(values[Index::eqEngine]);
+
+
+    settings.roomSize = values[Index::roomSize];
+    settings.damping = values[Index::damping];
+    settings.mix = values[Index::mix];
+    settings.reverbEngine = static_cast<ReverbEngine>(values[Index::reverbEngine]);
+    settings.preDelay = values[Index::preDelay];
+
+    settings.AnalyzerEnabled = values[Index::analyzerEnabled] > 0.5f;
+
+    return settings;
+}
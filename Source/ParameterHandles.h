@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+
+    ParameterHandles.h
+
+    Parameter IDs shared by createParameterLayout and every reader, plus
+    cached pointers to the parameter atomics so the hot path never looks
+    a parameter up by name.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ChainSettings.h"
+
+namespace ParameterIDs
+{
+    //EQ
+    inline constexpr const char* lowCutFreq   = "LowCut Freq";
+    inline constexpr const char* highCutFreq  = "HighCut Freq";
+    inline constexpr const char* peakFreq     = "Peak Freq";
+    inline constexpr const char* peakGain     = "Peak Gain";
+    inline constexpr const char* peakQuality  = "Peak Quality";
+    inline constexpr const char* lowCutSlope  = "LowCut Slope";
+    inline constexpr const char* highCutSlope = "HighCut Slope";
+    inline constexpr const char* inputEqBypassed = "EQ Bypassed";
+    inline constexpr const char* lowCutBypassed  = "LowCut Bypassed";
+    inline constexpr const char* peakBypassed    = "Peak Bypassed";
+    inline constexpr const char* highCutBypassed = "HighCut Bypassed";
+    inline constexpr const char* eqEngine        = "EQ Engine";
+
+    //Reverb
+    inline constexpr const char* mix      = "Mix";
+    inline constexpr const char* roomSize = "RoomSize";
+    inline constexpr const char* damping  = "Damping";
+    inline constexpr const char* reverbEngine = "Reverb Engine";
+    inline constexpr const char* preDelay = "Pre Delay";
+
+    //Display
+    inline constexpr const char* analyzerEnabled = "Analyzer";
+
+    inline constexpr std::array<const char*, 18> all
+    {
+        lowCutFreq, highCutFreq, peakFreq, peakGain, peakQuality, lowCutSlope, highCutSlope,
+        inputEqBypassed, lowCutBypassed, peakBypassed, highCutBypassed, eqEngine,
+        mix, roomSize, damping, reverbEngine, preDelay,
+        analyzerEnabled
+    };
+
+    constexpr bool equal(const char* a, const char* b)
+    {
+        while (*a != 0 && *a == *b)
+        {
+            ++a;
+            ++b;
+        }
+
+        return *a == *b;
+    }
+
+    constexpr bool allDistinct()
+    {
+        for (size_t i = 0; i < all.size(); ++i)
+            for (size_t j = i + 1; j < all.size(); ++j)
+                if (equal(all[i], all[j]))
+                    return false;
+
+        return true;
+    }
+
+    static_assert(allDistinct(), "Two parameters share the same ID");
+
+    // Position of an ID in `all`, or all.size() if it isn't there
+    constexpr size_t indexOf(const char* parameterID)
+    {
+        for (size_t i = 0; i < all.size(); ++i)
+            if (equal(all[i], parameterID))
+                return i;
+
+        return all.size();
+    }
+}
+
+// Plain (denormalised) value of every parameter, indexed like ParameterIDs::all
+using ParameterValues = std::array<float, ParameterIDs::all.size()>;
+
+// Resolved once in the constructor; load() only does relaxed atomic reads
+struct ParameterHandles
+{
+    explicit ParameterHandles(juce::AudioProcessorValueTreeState& apvts);
+
+    ChainSettings load() const noexcept;
+
+    // Same mapping for values that aren't live parameters, such as a stored preset
+    static ChainSettings load(const ParameterValues& values) noexcept;
+
+    // Indexed like ParameterIDs::all
+    std::array<std::atomic<float>*, ParameterIDs::all.size()> handles;
+};
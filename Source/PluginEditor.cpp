@@ -9,17 +9,44 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 
+namespace
+{
+    constexpr int traceRowHeight = 28;
+}
+
 //==============================================================================
 SimplePluginAudioProcessorEditor::SimplePluginAudioProcessorEditor (SimplePluginAudioProcessor& p)
-    : AudioProcessorEditor (&p), audioProcessor (p)
+    : AudioProcessorEditor (&p), audioProcessor (p), parameterEditor (p), analyzerView (p.getAnalyzer(), p.getDesigner()), stageLoadView (p.getProfiler(), p.getDesigner())
 {
+    addAndMakeVisible (parameterEditor);
+    addAndMakeVisible (analyzerView);
+    addAndMakeVisible (stageLoadView);
+
+    addAndMakeVisible (traceButton);
+    traceButton.setEnabled (StageProfiler::isEnabled);
+    traceButton.onClick = [this] { toggleTrace(); };
+
+    addAndMakeVisible (traceLabel);
+    traceLabel.setFont (12.0f);
+
+    addAndMakeVisible (compareButton);
+    compareButton.setTooltip ("Store the current settings and switch to the other compare slot");
+    compareButton.onClick = [this]
+    {
+        audioProcessor.toggleCompareSlot();
+        updateCompareButton();
+    };
+    updateCompareButton();
+
     // Make sure that before the constructor has finished, you've set the
     // editor's size to whatever you need it to be.
-    setSize (400, 300);
+    setSize (juce::jmax (400, parameterEditor.getWidth()),
+             parameterEditor.getHeight() + AnalyzerView::preferredHeight + StageLoadView::getPreferredHeight() + traceRowHeight);
 }
 
 SimplePluginAudioProcessorEditor::~SimplePluginAudioProcessorEditor()
 {
+    audioProcessor.getProfiler().stopTrace();
 }
 
 //==============================================================================
@@ -27,14 +54,47 @@ void SimplePluginAudioProcessorEditor::paint (juce::Graphics& g)
 {
     // (Our component is opaque, so we must completely fill the background with a solid colour)
     g.fillAll (getLookAndFeel().findColour (juce::ResizableWindow::backgroundColourId));
-
-    g.setColour (juce::Colours::white);
-    g.setFont (15.0f);
-    g.drawFittedText ("Hello World!", getLocalBounds(), juce::Justification::centred, 1);
 }
 
 void SimplePluginAudioProcessorEditor::resized()
 {
-    // This is generally where you'll want to lay out the positions of any
-    // subcomponents in your editor..
+    auto bounds = getLocalBounds();
+
+    auto traceRow = bounds.removeFromBottom (traceRowHeight).reduced (4);
+    traceButton.setBounds (traceRow.removeFromLeft (110));
+    compareButton.setBounds (traceRow.removeFromRight (60));
+    traceLabel.setBounds (traceRow);
+
+    stageLoadView.setBounds (bounds.removeFromBottom (StageLoadView::getPreferredHeight()));
+    analyzerView.setBounds (bounds.removeFromBottom (AnalyzerView::preferredHeight));
+    parameterEditor.setBounds (bounds);
+}
+
+void SimplePluginAudioProcessorEditor::updateCompareButton()
+{
+    compareButton.setButtonText (audioProcessor.getCompareSlot() == PresetBank::slotA ? "A > B" : "B > A");
+}
+
+void SimplePluginAudioProcessorEditor::toggleTrace()
+{
+    auto& profiler = audioProcessor.getProfiler();
+
+    if (! profiler.isTracing())
+    {
+        profiler.startTrace();
+        traceButton.setButtonText ("Stop trace");
+        traceLabel.setText ("Recording...", juce::dontSendNotification);
+        return;
+    }
+
+    profiler.stopTrace();
+    traceButton.setButtonText ("Record trace");
+
+    // Open in chrome://tracing or ui.perfetto.dev
+    auto file = juce::File::getSpecialLocation (juce::File::userDocumentsDirectory)
+                    .getNonexistentChildFile ("SimplePlugin trace", ".json");
+
+    traceLabel.setText (profiler.writeChromeTrace (file) ? "Written to " + file.getFullPathName()
+                                                         : "Can't write " + file.getFullPathName(),
+                        juce::dontSendNotification);
 }
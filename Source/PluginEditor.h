@@ -10,6 +10,8 @@
 
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
+#include "AnalyzerView.h"
+#include "StageLoadView.h"
 
 //==============================================================================
 /**
@@ -25,9 +27,26 @@ public:
     void resized() override;
 
 private:
+    void toggleTrace();
+    void updateCompareButton();
+
     // This reference is provided as a quick way for your editor to
     // access the processor object that created it.
     SimplePluginAudioProcessor& audioProcessor;
 
+    // Parameter controls
+    juce::GenericAudioProcessorEditor parameterEditor;
+
+    // Pre- and post-EQ spectrum with the EQ response
+    AnalyzerView analyzerView;
+
+    // =======Profiling=======
+    StageLoadView stageLoadView;
+    juce::TextButton traceButton{ "Record trace" };
+    juce::Label traceLabel;
+
+    // =======A/B Compare=======
+    juce::TextButton compareButton;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimplePluginAudioProcessorEditor)
 };
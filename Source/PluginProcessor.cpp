@@ -9,6 +9,36 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 
+namespace
+{
+    // Runs a bank of stereo engines over the block, one engine per pair of channels
+    template <typename Engine>
+    void processChannelPairs(std::vector<std::unique_ptr<Engine>>& engines, juce::dsp::AudioBlock<float>& block) noexcept
+    {
+        for (size_t pair = 0; pair < engines.size() && pair * 2 < block.getNumChannels(); ++pair)
+        {
+            auto pairBlock = block.getSubsetChannelBlock(pair * 2, juce::jmin((size_t) 2, block.getNumChannels() - pair * 2));
+            engines[pair]->process(juce::dsp::ProcessContextReplacing<float>(pairBlock));
+        }
+    }
+
+    // Linear crossfade from `from` into `to`, written to `to`; position counts the samples already faded
+    void crossfade(juce::dsp::AudioBlock<float>& to, const juce::dsp::AudioBlock<float>& from, int position, int length) noexcept
+    {
+        for (size_t channel = 0; channel < to.getNumChannels(); ++channel)
+        {
+            auto* destination = to.getChannelPointer(channel);
+            const auto* source = from.getChannelPointer(channel);
+
+            for (size_t i = 0; i < to.getNumSamples(); ++i)
+            {
+                auto gain = juce::jmin(1.0f, (float) (position + (int) i) / (float) length);
+                destination[i] = source[i] + gain * (destination[i] - source[i]);
+            }
+        }
+    }
+}
+
 //==============================================================================
 SimplePluginAudioProcessor::SimplePluginAudioProcessor()
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -22,10 +52,21 @@ SimplePluginAudioProcessor::SimplePluginAudioProcessor()
                        )
 #endif
 {
+    for (size_t index = 0; index < ParameterIDs::all.size(); ++index)
+    {
+        apvts.addParameterListener(ParameterIDs::all[index], this);
+
+        stateParameters[index] = apvts.getParameter(ParameterIDs::all[index]);
+        jassert(stateParameters[index] != nullptr);
+    }
+
+    analyzer.setEnabled(apvts.getRawParameterValue(ParameterIDs::analyzerEnabled)->load() > 0.5f);
 }
 
 SimplePluginAudioProcessor::~SimplePluginAudioProcessor()
 {
+    for (auto* parameterID : ParameterIDs::all)
+        apvts.removeParameterListener(parameterID, this);
 }
 
 //==============================================================================
@@ -63,31 +104,54 @@ bool SimplePluginAudioProcessor::isMidiEffect() const
 
 double SimplePluginAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    return tailLengthSeconds.load(std::memory_order_relaxed);
 }
 
 int SimplePluginAudioProcessor::getNumPrograms()
 {
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
-                // so this should be at least 1, even if you're not really implementing programs.
+    return presetBank.getNumPrograms();
 }
 
 int SimplePluginAudioProcessor::getCurrentProgram()
 {
-    return 0;
+    return currentProgram.load();
 }
 
 void SimplePluginAudioProcessor::setCurrentProgram (int index)
 {
+    if (! juce::isPositiveAndBelow(index, presetBank.getNumPrograms()))
+        return;
+
+    currentProgram.store(index);
+
+    const auto& program = presetBank.getProgram(index);
+    applyParameterValues(program.values, &program.coefficients);
 }
 
 const juce::String SimplePluginAudioProcessor::getProgramName (int index)
 {
-    return {};
+    return juce::isPositiveAndBelow(index, presetBank.getNumPrograms()) ? presetBank.getProgramName(index) : juce::String();
 }
 
 void SimplePluginAudioProcessor::changeProgramName (int index, const juce::String& newName)
 {
+    presetBank.setProgramName(index, newName);
+}
+
+void SimplePluginAudioProcessor::toggleCompareSlot()
+{
+    auto other = compareSlot == PresetBank::slotA ? PresetBank::slotB : PresetBank::slotA;
+    auto values = getParameterValues();
+
+    presetBank.storeCompareSlot(compareSlot, values);
+
+    if (presetBank.getCompareSlot(other) == nullptr)
+        presetBank.storeCompareSlot(other, values);
+
+    compareSlot = other;
+
+    const auto* entry = presetBank.getCompareSlot(other);
+    applyParameterValues(entry->values, &entry->coefficients);
 }
 
 //==============================================================================
@@ -95,55 +159,99 @@ void SimplePluginAudioProcessor::prepareToPlay (double sampleRate, int samplesPe
 {
     juce::dsp::ProcessSpec spec;
     spec.maximumBlockSize = samplesPerBlock;
-    spec.numChannels = 1;
+    spec.numChannels = (juce::uint32) juce::jmax(1, getTotalNumInputChannels(), getTotalNumOutputChannels());
     spec.sampleRate = sampleRate;
 
     // Prepare Chain
-    leftChain.prepare(spec);
-    rightChain.prepare(spec);
+    filterChain.prepare(spec);
+    eqSmoother.prepare(sampleRate, ButterworthTable::getShared(sampleRate));
+    svfChain.prepare(spec);
 
     // Prepare the Reverb effect
-    spec.numChannels = 2; // Assuming stereo input/output
-    reverb.prepare(spec);
+    customReverb.prepare(spec);
 
-    
+    auto numPairs = ((size_t) spec.numChannels + 1) / 2;
+    auto impulseResponseFile = juce::File(apvts.state.getProperty(impulseResponseProperty).toString());
 
+    while (reverbs.size() < numPairs)
+        reverbs.push_back(std::make_unique<juce::dsp::Reverb>());
 
-    auto chainSettings = getChainSettings(apvts);
+    // Engines added for a wider layout load the current impulse response as well
+    while (convolutions.size() < numPairs)
+    {
+        convolutions.push_back(std::make_unique<juce::dsp::Convolution>(juce::dsp::Convolution::NonUniform{ convolutionHeadSize }, convolutionQueue));
+
+        if (impulseResponseFile.existsAsFile())
+            loadImpulseResponse(*convolutions.back(), impulseResponseFile);
+    }
+
+    reverbs.resize(numPairs);
+    convolutions.resize(numPairs);
+
+    for (size_t pair = 0; pair < numPairs; ++pair)
+    {
+        auto pairSpec = spec;
+        pairSpec.numChannels = juce::jmin((juce::uint32) 2, spec.numChannels - (juce::uint32) pair * 2);
+
+        reverbs[pair]->prepare(pairSpec);
+        convolutions[pair]->prepare(pairSpec);
+    }
 
-    
+    // Zero with the non-uniform head, but reported in case the partitioning is ever changed to need it
+    setLatencySamples(convolutions.front()->getLatency());
 
-    updatePeakFilter(chainSettings);
+    // Sized once here, so neither a delay change nor a block of any size up to samplesPerBlock allocates
+    preDelay.prepare(spec);
+    wetBuffer.setSize((int) spec.numChannels, juce::jmax(1, samplesPerBlock));
+    fadingWetBuffer.setSize((int) spec.numChannels, juce::jmax(1, samplesPerBlock));
+    fadingEqBuffer.setSize((int) spec.numChannels, juce::jmax(1, samplesPerBlock));
 
-    auto lowCutCoefficients = juce::dsp::FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod(chainSettings.lowCutFreq, sampleRate, 2 * (chainSettings.lowCutSlope + 1));
-    
-    //Left Lowcut
-    auto& leftLowCut = leftChain.get<ChainPositions::LowCut>();
-    updateCutFilter(leftLowCut, lowCutCoefficients, chainSettings.lowCutSlope);
+    dryGain.reset(sampleRate, 0.05);
+    convolutionGain.reset(sampleRate, 0.05);
 
-    //Right Lowcut
-    auto& rightLowCut = rightChain.get<ChainPositions::LowCut>();
-    updateCutFilter(rightLowCut, lowCutCoefficients, chainSettings.lowCutSlope);
+    // Longer than every wet gain ramp, so the wet path is silent by the time it stops running
+    reverbFadeOutSamples = juce::roundToInt(reverbFadeOutSeconds * sampleRate);
+    samplesUntilReverbIdle = reverbFadeOutSamples;
+    reverbEngineFadePosition = reverbFadeOutSamples;
+    eqEngineFadeSamples = juce::jmax(1, juce::roundToInt(eqEngineFadeSeconds * sampleRate));
+    eqEngineFadePosition = eqEngineFadeSamples;
 
-    auto highCutCoefficients = juce::dsp::FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod(chainSettings.highCutFreq, sampleRate, 2 * (chainSettings.highCutSlope + 1));
+    currentSampleRate = sampleRate;
+    silenceDetector.prepare(sampleRate);
 
-    //Left Highcut
-    auto& leftHighCut = leftChain.get<ChainPositions::LowCut>();
-    updateCutFilter(leftHighCut, highCutCoefficients, chainSettings.lowCutSlope);
+    profiler.prepare(sampleRate);
+    profiler.getSnapshot(profileAtPrepare);
 
-    //Right Highcut
-    auto& rightHighCut = rightChain.get<ChainPositions::LowCut>();
-    updateCutFilter(rightHighCut, highCutCoefficients, chainSettings.lowCutSlope);
+    analyzer.prepare(sampleRate);
 
+    // Everything has to be designed for the new sample rate before the first block
+    designer.prepare(sampleRate);
+    presetBank.prepare(sampleRate);
 
-    updateReverbParameters(chainSettings);
+    // A preset picked before playback is already in the parameters the designer just read
+    pendingPreset.store(nullptr);
+    presetGeneration = designer.getLatest().parameterGeneration;
 
+    if (designer.pullLatest())
+        applyCoefficients(designer.getLatest());
+
+    dryGain.setCurrentAndTargetValue(dryGain.getTargetValue());
+    convolutionGain.setCurrentAndTargetValue(convolutionGain.getTargetValue());
+    preDelay.reset();
 }
 
 void SimplePluginAudioProcessor::releaseResources()
 {
     // When playback stops, you can use this as an opportunity to free up any
     // spare memory, etc.
+
+    if (StageProfiler::isEnabled)
+    {
+        StageProfiler::Snapshot profile;
+        profiler.getSnapshot(profile);
+        juce::Logger::writeToLog(StageProfiler::createReport(profile, profileAtPrepare));
+    }
+    designer.release();
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -153,12 +261,9 @@ bool SimplePluginAudioProcessor::isBusesLayoutSupported (const BusesLayout& layo
     juce::ignoreUnused (layouts);
     return true;
   #else
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    // Some plugin hosts, such as certain GarageBand versions, will only
-    // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // Every stage works on any number of channels, so any layout is supported:
+    // mono, stereo, surround such as 5.1 or 7.1.4, and ambisonics of any order.
+    if (layouts.getMainOutputChannelSet().isDisabled())
         return false;
 
     // This checks if the input layout matches the output layout
@@ -174,6 +279,14 @@ bool SimplePluginAudioProcessor::isBusesLayoutSupported (const BusesLayout& layo
 
 void SimplePluginAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
+    // An offline instance without a designer thread designs here, outside the real-time checks
+    if (designer.isRunningInline())
+        designer.designPending();
+
+    // Debug builds on Linux report every allocation, free or mutex lock until the block is done
+    RealtimeSafety::ScopedRealtimeContext realtimeContext;
+    StageProfiler::ScopedBlock profiledBlock(profiler, buffer.getNumSamples());
+
     juce::ScopedNoDenormals noDenormals;
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
@@ -189,54 +302,220 @@ void SimplePluginAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
 
 
     // =====================
-    //Peak
-    auto chainSettings = getChainSettings(apvts);
+    // Pick up a preset switch, or else the newest coefficient set published by the designer thread
+    bool hasNewCoefficients;
+    const ChainCoefficients* preset;
+
+    {
+        StageProfiler::ScopedStage stage(profiler, StageProfiler::parameterFetch);
+        hasNewCoefficients = designer.pullLatest();
+        preset = pendingPreset.exchange(nullptr, std::memory_order_acquire);
+
+        if (preset != nullptr)
+            presetGeneration = pendingPresetGeneration.load(std::memory_order_relaxed);
+
+        // Read before the preset's batch: applying it would undo the switch until the next redesign
+        hasNewCoefficients = hasNewCoefficients && (int32_t) (designer.getLatest().parameterGeneration - presetGeneration) >= 0;
+    }
+
+    if (preset != nullptr)
+    {
+        StageProfiler::ScopedStage stage(profiler, StageProfiler::coefficientUpdate);
+        applyCoefficients(*preset, true);
+    }
+    else if (hasNewCoefficients)
+    {
+        StageProfiler::ScopedStage stage(profiler, StageProfiler::coefficientUpdate);
+        applyCoefficients(designer.getLatest());
+    }
+
+    // =====================
 
-    updatePeakFilter(chainSettings);
 
 
-    //Lowcut
-    auto cutCoefficients = juce::dsp::FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod(chainSettings.lowCutFreq, getSampleRate(), 2 * (chainSettings.lowCutSlope + 1));
+    juce::dsp::AudioBlock<float> block(buffer);
 
-    auto& leftLowCut = leftChain.get<ChainPositions::LowCut>();
-    updateCutFilter(leftLowCut, cutCoefficients, chainSettings.lowCutSlope);
+    // Silent input and a tail that has died away: nothing to compute until signal returns
+    switch (silenceDetector.checkInput(block))
+    {
+        case SilenceDetector::Activity::idle:
+            block.clear();
+            return;
+
+        case SilenceDetector::Activity::resuming:
+            // Whatever the chain still holds is below the threshold, start from true silence
+            filterChain.reset();
+            svfChain.reset();
+            preDelay.reset();
+            resetReverbEngine(reverbEngine);
+            eqEngineFadePosition = eqEngineFadeSamples;
+            reverbEngineFadePosition = reverbFadeOutSamples;
+            break;
+
+        case SilenceDetector::Activity::active:
+        default:
+            break;
+    }
 
-    auto& rightLowCut = rightChain.get<ChainPositions::LowCut>();
-    updateCutFilter(rightLowCut, cutCoefficients, chainSettings.lowCutSlope);
+    if (reverbEngine == ReverbEngine::Convolution && convolutions.front()->getCurrentIRSize() != convolutionTailSamples)
+    {
+        convolutionTailSamples = convolutions.front()->getCurrentIRSize();
+        updateTailLength(designer.getLatest());
+    }
 
+    analyzer.push(SpectrumAnalyzer::preEq, block);
 
-    //Highcut
-    auto highCutCoefficients = juce::dsp::FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod(chainSettings.highCutFreq, getSampleRate(), 2 * (chainSettings.highCutSlope + 1));
+    // Every channel through low cut, peak and high cut, up to one SIMD register of channels per pass
+    {
+        StageProfiler::ScopedStage stage(profiler, StageProfiler::equaliser);
+        processEqualiser(block);
+    }
 
-    auto& leftHighCut = leftChain.get<ChainPositions::HighCut>();
-    updateCutFilter(leftHighCut, highCutCoefficients, chainSettings.highCutSlope);
+    analyzer.push(SpectrumAnalyzer::postEq, block);
 
-    auto& rightHighCut = rightChain.get<ChainPositions::HighCut>();
-    updateCutFilter(rightHighCut, highCutCoefficients, chainSettings.highCutSlope);
+    // Mix 0: once the wet path has faded out only the dry gain is left to apply. It isn't always
+    // unity at Mix 0, Freeverb's dry path is scaled to match its wet level.
+    if (reverbActive || samplesUntilReverbIdle > 0)
+    {
+        if (! reverbActive)
+            samplesUntilReverbIdle -= buffer.getNumSamples();
 
-    // =====================
+        processReverb(block);
+    }
+    else if (dryGain.isSmoothing() || dryGain.getTargetValue() != 1.0f)
+    {
+        StageProfiler::ScopedStage stage(profiler, StageProfiler::mix);
+        block.multiplyBy(dryGain);
+    }
 
+    silenceDetector.checkOutput(block);
+}
 
+void SimplePluginAudioProcessor::processEqualiser(juce::dsp::AudioBlock<float>& block) noexcept
+{
+    if (eqEngineFadePosition >= eqEngineFadeSamples)
+    {
+        runEqEngine(eqEngine, block);
+        return;
+    }
 
-    juce::dsp::AudioBlock<float> block(buffer);
+    // Hosts may send more samples than prepareToPlay announced
+    auto maxChunkSize = (size_t) fadingEqBuffer.getNumSamples();
+    auto numChannels = juce::jmin(block.getNumChannels(), (size_t) fadingEqBuffer.getNumChannels());
+
+    for (size_t start = 0; start < block.getNumSamples(); start += maxChunkSize)
+    {
+        auto chunk = block.getSubBlock(start, juce::jmin(maxChunkSize, block.getNumSamples() - start));
+
+        if (eqEngineFadePosition >= eqEngineFadeSamples)
+        {
+            runEqEngine(eqEngine, chunk);
+            continue;
+        }
+
+        auto fadingChunk = juce::dsp::AudioBlock<float>(fadingEqBuffer)
+                               .getSubsetChannelBlock(0, numChannels)
+                               .getSubBlock(0, chunk.getNumSamples());
+        fadingChunk.copyFrom(chunk);
+
+        runEqEngine(fadingEqEngine, fadingChunk);
+        runEqEngine(eqEngine, chunk);
+
+        auto fadedChunk = chunk.getSubsetChannelBlock(0, numChannels);
+        crossfade(fadedChunk, fadingChunk, eqEngineFadePosition, eqEngineFadeSamples);
+        eqEngineFadePosition += (int) chunk.getNumSamples();
+    }
+}
 
-    auto leftBlock = block.getSingleChannelBlock(0);
-    auto rightBlock = block.getSingleChannelBlock(1);
+void SimplePluginAudioProcessor::runEqEngine(EqEngine engine, juce::dsp::AudioBlock<float>& block) noexcept
+{
+    juce::dsp::ProcessContextReplacing<float> context(block);
 
-    juce::dsp::ProcessContextReplacing<float> leftContext(leftBlock);
-    juce::dsp::ProcessContextReplacing<float> rightContext(rightBlock);
+    if (engine == EqEngine::StateVariable)
+    {
+        svfChain.process(context);
+    }
+    else
+    {
+        eqSmoother.setControlBlockSize(controlBlockSize.load(std::memory_order_relaxed));
+        eqSmoother.process(filterChain, context);
+    }
+}
 
-    leftChain.process(leftContext);
-    rightChain.process(rightContext);
+void SimplePluginAudioProcessor::processReverb(juce::dsp::AudioBlock<float>& block) noexcept
+{
+    // Hosts may send more samples than prepareToPlay announced
+    auto maxChunkSize = (size_t) wetBuffer.getNumSamples();
 
-    // Update reverb parameters
-    updateReverbParameters(chainSettings);
+    for (size_t start = 0; start < block.getNumSamples(); start += maxChunkSize)
+    {
+        auto chunk = block.getSubBlock(start, juce::jmin(maxChunkSize, block.getNumSamples() - start));
+        processReverbChunk(chunk);
+    }
+}
+
+void SimplePluginAudioProcessor::processReverbChunk(juce::dsp::AudioBlock<float>& block) noexcept
+{
+    // The pre-delay reads the filtered signal and writes the delayed copy straight into the wet buffer,
+    // which the reverb then processes in place
+    auto wetBlock = juce::dsp::AudioBlock<float>(wetBuffer)
+                        .getSubsetChannelBlock(0, juce::jmin(block.getNumChannels(), (size_t) wetBuffer.getNumChannels()))
+                        .getSubBlock(0, block.getNumSamples());
+    auto dryBlock = block.getSubsetChannelBlock(0, wetBlock.getNumChannels());
+
+    {
+        StageProfiler::ScopedStage stage(profiler, StageProfiler::preDelay);
+        preDelay.process(dryBlock, wetBlock);
+    }
 
     // Apply reverb effect
-    juce::dsp::AudioBlock<float> reverbBlock(buffer);
-    juce::dsp::ProcessContextReplacing<float> reverbContext(reverbBlock);
-    reverb.process(reverbContext);
+    {
+        StageProfiler::ScopedStage stage(profiler, StageProfiler::reverb);
+
+        if (reverbEngineFadePosition < reverbFadeOutSamples)
+        {
+            auto fadingBlock = juce::dsp::AudioBlock<float>(fadingWetBuffer)
+                                   .getSubsetChannelBlock(0, wetBlock.getNumChannels())
+                                   .getSubBlock(0, wetBlock.getNumSamples());
+            fadingBlock.copyFrom(wetBlock);
+
+            runReverbEngine(fadingReverbEngine, fadingBlock);
+            runReverbEngine(reverbEngine, wetBlock);
+
+            crossfade(wetBlock, fadingBlock, reverbEngineFadePosition, reverbFadeOutSamples);
+            reverbEngineFadePosition += (int) wetBlock.getNumSamples();
+        }
+        else
+        {
+            runReverbEngine(reverbEngine, wetBlock);
+        }
+    }
 
+    {
+        StageProfiler::ScopedStage stage(profiler, StageProfiler::mix);
+        dryBlock.multiplyBy(dryGain);
+        dryBlock.add(wetBlock);
+    }
+}
+
+void SimplePluginAudioProcessor::runReverbEngine(ReverbEngine engine, juce::dsp::AudioBlock<float>& wetBlock) noexcept
+{
+    switch (engine)
+    {
+        case ReverbEngine::FeedbackDelayNetwork:
+            customReverb.process(juce::dsp::ProcessContextReplacing<float>(wetBlock));
+            break;
+
+        case ReverbEngine::Convolution:
+            processChannelPairs(convolutions, wetBlock);
+            wetBlock.multiplyBy(convolutionGain);
+            break;
+
+        case ReverbEngine::Freeverb:
+        default:
+            processChannelPairs(reverbs, wetBlock);
+            break;
+    }
 }
 
 //==============================================================================
@@ -248,23 +527,51 @@ bool SimplePluginAudioProcessor::hasEditor() const
 juce::AudioProcessorEditor* SimplePluginAudioProcessor::createEditor()
 {
 
-    //return new SimplePluginAudioProcessorEditor (*this);
-    return new ::juce::GenericAudioProcessorEditor(*this);
+    return new SimplePluginAudioProcessorEditor (*this);
 
 }
 
 //==============================================================================
 void SimplePluginAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    // You should use this method to store your parameters in the memory block.
-    // You could do that either as raw data, or use the XML or ValueTree classes
-    // as intermediaries to make it easy to save and load complex data.
+    // Binary instead of the APVTS ValueTree as XML, so reopening a session with hundreds of instances stays fast
+    PluginState::Contents contents;
+    contents.values = getParameterValues();
+    contents.impulseResponsePath = apvts.state.getProperty(impulseResponseProperty).toString();
+
+    PluginState::write(contents, destData);
 }
 
 void SimplePluginAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
-    // You should use this method to restore your parameters from this memory block,
-    // whose contents will have been created by the getStateInformation() call.
+    PluginState::Contents contents;
+
+    if (sizeInBytes <= 0 || ! PluginState::read(data, (size_t) sizeInBytes, contents))
+    {
+        // Not a state this plugin wrote; keep the current settings
+        return;
+    }
+
+    // Parameters added after the state was written start from their defaults
+    auto values = getDefaultValues(apvts);
+
+    for (size_t index = 0; index < PluginState::numParameters; ++index)
+        if (contents.hasValue[index])
+            values[index] = contents.values[index];
+
+    applyParameterValues(values);
+
+    auto currentImpulseResponse = apvts.state.getProperty(impulseResponseProperty).toString();
+
+    if (contents.impulseResponsePath != currentImpulseResponse)
+    {
+        auto impulseResponseFile = juce::File::createFileWithoutCheckingPath(contents.impulseResponsePath);
+
+        if (contents.impulseResponsePath.isNotEmpty() && impulseResponseFile.existsAsFile())
+            loadImpulseResponse(impulseResponseFile);
+        else
+            apvts.state.setProperty(impulseResponseProperty, contents.impulseResponsePath, nullptr);
+    }
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout SimplePluginAudioProcessor::createParameterLayout()
@@ -275,31 +582,31 @@ juce::AudioProcessorValueTreeState::ParameterLayout SimplePluginAudioProcessor::
     //===============SIMPLE EQ FOR INPUT===================
 
     //LowCut Frequency
-    parameterLayout.add(std::make_unique<juce::AudioParameterFloat>("LowCut Freq",
+    parameterLayout.add(std::make_unique<juce::AudioParameterFloat>(ParameterIDs::lowCutFreq,
         "LowCut Freq",
         juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f),
         20.f));
 
     //HighCut Freqency
-    parameterLayout.add(std::make_unique<juce::AudioParameterFloat>("HighCut Freq",
+    parameterLayout.add(std::make_unique<juce::AudioParameterFloat>(ParameterIDs::highCutFreq,
         "HighCut Freq",
         juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f),
         20000.f));
 
     //Peak Frequency
-    parameterLayout.add(std::make_unique<juce::AudioParameterFloat>("Peak Freq",
+    parameterLayout.add(std::make_unique<juce::AudioParameterFloat>(ParameterIDs::peakFreq,
         "Peak Freq",
         juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f),
         750.f));
 
     //Peak Gain
-    parameterLayout.add(std::make_unique<juce::AudioParameterFloat>("Peak Gain",
+    parameterLayout.add(std::make_unique<juce::AudioParameterFloat>(ParameterIDs::peakGain,
         "Peak Gain",
         juce::NormalisableRange<float>(-24.f, 24.f, 0.5f, 1.f),
         0.0f));
 
     //Peak Quality
-    parameterLayout.add(std::make_unique<juce::AudioParameterFloat>("Peak Quality",
+    parameterLayout.add(std::make_unique<juce::AudioParameterFloat>(ParameterIDs::peakQuality,
         "Peak Quality",
         juce::NormalisableRange<float>(0.1f, 10.f, 0.05f, 1.f),
         1.f));
@@ -315,73 +622,236 @@ juce::AudioProcessorValueTreeState::ParameterLayout SimplePluginAudioProcessor::
     }
 
     //Slope-Choice
-    parameterLayout.add(std::make_unique<juce::AudioParameterChoice>("LowCut Slope", "LowCut Slope", stringArray, 0));
-    parameterLayout.add(std::make_unique<juce::AudioParameterChoice>("HighCut Slope", "HighCut Slope", stringArray, 0));
+    parameterLayout.add(std::make_unique<juce::AudioParameterChoice>(ParameterIDs::lowCutSlope, "LowCut Slope", stringArray, 0));
+    parameterLayout.add(std::make_unique<juce::AudioParameterChoice>(ParameterIDs::highCutSlope, "HighCut Slope", stringArray, 0));
+
+    //Bypass
+    parameterLayout.add(std::make_unique<juce::AudioParameterBool>(ParameterIDs::lowCutBypassed, "LowCut Bypassed", false));
+    parameterLayout.add(std::make_unique<juce::AudioParameterBool>(ParameterIDs::peakBypassed, "Peak Bypassed", false));
+    parameterLayout.add(std::make_unique<juce::AudioParameterBool>(ParameterIDs::highCutBypassed, "HighCut Bypassed", false));
+    parameterLayout.add(std::make_unique<juce::AudioParameterBool>(ParameterIDs::inputEqBypassed, "EQ Bypassed", false));
+
+    //Engine
+    parameterLayout.add(std::make_unique<juce::AudioParameterChoice>(
+        ParameterIDs::eqEngine, "EQ Engine", juce::StringArray{ "Biquad", "State Variable" }, 0));
 
 
     //===================REVERB===================
     // Mix parameter
     parameterLayout.add(std::make_unique<juce::AudioParameterFloat>(
-        "Mix", "Mix", 0.0f, 1.0f, 0.5f));
+        ParameterIDs::mix, "Mix", 0.0f, 1.0f, 0.5f));
 
     // Room size parameter
     parameterLayout.add(std::make_unique<juce::AudioParameterFloat>(
-        "RoomSize", "Room Size", 0.0f, 1.0f, 0.5f));
+        ParameterIDs::roomSize, "Room Size", 0.0f, 1.0f, 0.5f));
 
     // Damping parameter
     parameterLayout.add(std::make_unique<juce::AudioParameterFloat>(
-        "Damping", "Damping", 0.0f, 1.0f, 0.5f));
+        ParameterIDs::damping, "Damping", 0.0f, 1.0f, 0.5f));
+
+    // Pre-delay of the wet signal in ms
+    parameterLayout.add(std::make_unique<juce::AudioParameterFloat>(
+        ParameterIDs::preDelay, "Pre Delay",
+        juce::NormalisableRange<float>(0.0f, PreDelay::maxDelaySeconds * 1000.0f, 0.1f, 0.5f),
+        0.0f));
+
+    // Reverb engine
+    parameterLayout.add(std::make_unique<juce::AudioParameterChoice>(
+        ParameterIDs::reverbEngine, "Reverb Engine", juce::StringArray{ "Freeverb", "FDN", "Convolution" }, 0));
+
+
+    //===================DISPLAY===================
+    // Spectrum analyzer in the editor
+    parameterLayout.add(std::make_unique<juce::AudioParameterBool>(
+        ParameterIDs::analyzerEnabled, "Analyzer", true));
 
     return parameterLayout;
 }
 
-ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& apvts)
+void SimplePluginAudioProcessor::loadImpulseResponse(const juce::File& impulseResponseFile)
 {
-    ChainSettings settings;
-    settings.lowCutFreq = apvts.getRawParameterValue("LowCut Freq")->load();
-    settings.highCutFreq = apvts.getRawParameterValue("HighCut Freq")->load();
-    settings.peakFreq = apvts.getRawParameterValue("Peak Freq")->load();
-    settings.peakGainInDecibels = apvts.getRawParameterValue("Peak Gain")->load();
-    settings.peakQuality = apvts.getRawParameterValue("Peak Quality")->load();
-    settings.highCutSlope = static_cast<Slope>(apvts.getRawParameterValue("HighCut Slope")->load());
-    settings.lowCutSlope = static_cast<Slope>(apvts.getRawParameterValue("LowCut Slope")->load());
+    for (auto& convolution : convolutions)
+        loadImpulseResponse(*convolution, impulseResponseFile);
+
+    // Engines created by a later prepareToPlay pick the file up from here
+    apvts.state.setProperty(impulseResponseProperty, impulseResponseFile.getFullPathName(), nullptr);
+}
 
+void SimplePluginAudioProcessor::loadImpulseResponse(juce::dsp::Convolution& convolution, const juce::File& impulseResponseFile)
+{
+    // Decoding, resampling to the prepared sample rate and partitioning all happen on the
+    // convolution queue's background thread; the finished engine is swapped in without blocking
+    convolution.loadImpulseResponse(impulseResponseFile,
+                                    juce::dsp::Convolution::Stereo::yes,
+                                    juce::dsp::Convolution::Trim::yes,
+                                    0,
+                                    juce::dsp::Convolution::Normalise::yes);
+}
 
-    settings.roomSize = apvts.getRawParameterValue("RoomSize")->load();
-    settings.damping = apvts.getRawParameterValue("Damping")->load();
-    settings.mix = apvts.getRawParameterValue("Mix")->load();
+void SimplePluginAudioProcessor::parameterChanged(const juce::String& parameterID, float newValue)
+{
+    // May be called from any thread, including the audio thread during host automation
+    if (parameterID == ParameterIDs::analyzerEnabled)
+    {
+        analyzer.setEnabled(newValue > 0.5f);
+        return;
+    }
 
-    return settings;
+    // applyParameterValues marks everything dirty once it has set every parameter
+    if (isApplyingValues.load(std::memory_order_relaxed))
+        return;
+
+    designer.markDirty(CoefficientDesigner::getStagesForParameter(parameterID));
+}
+
+ParameterValues SimplePluginAudioProcessor::getParameterValues() const
+{
+    ParameterValues values;
+
+    for (size_t index = 0; index < values.size(); ++index)
+    {
+        auto* parameter = stateParameters[index];
+        values[index] = parameter->convertFrom0to1(parameter->getValue());
+    }
+
+    return values;
 }
 
+ParameterValues SimplePluginAudioProcessor::getDefaultValues(juce::AudioProcessorValueTreeState& state)
+{
+    ParameterValues values;
+
+    for (size_t index = 0; index < values.size(); ++index)
+    {
+        auto* parameter = state.getParameter(ParameterIDs::all[index]);
+        values[index] = parameter->convertFrom0to1(parameter->getDefaultValue());
+    }
 
+    return values;
+}
 
-void SimplePluginAudioProcessor::updatePeakFilter(const ChainSettings& chainSettings)
+void SimplePluginAudioProcessor::applyParameterValues(const ParameterValues& values, const ChainCoefficients* precomputed)
 {
-    auto peakCoefficients = juce::dsp::IIR::Coefficients<float>::makePeakFilter(getSampleRate(), chainSettings.peakFreq, chainSettings.peakQuality, juce::Decibels::decibelsToGain(chainSettings.peakGainInDecibels));
+    // The designer won't publish anything read halfway through the writes
+    auto generation = designer.beginParameterBatch();
+
+    if (precomputed != nullptr)
+    {
+        pendingPresetGeneration.store(generation, std::memory_order_relaxed);
+        pendingPreset.store(precomputed, std::memory_order_release);
+    }
 
-    updateCoefficients(leftChain.get<ChainPositions::Peak>().coefficients, peakCoefficients);
-    updateCoefficients(rightChain.get<ChainPositions::Peak>().coefficients, peakCoefficients);
+    isApplyingValues.store(true);
 
+    for (size_t index = 0; index < values.size(); ++index)
+    {
+        auto* parameter = stateParameters[index];
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(values[index]));
+    }
 
+    isApplyingValues.store(false);
+
+    // One redesign for the whole set instead of one per parameter
+    designer.endParameterBatch();
+    designer.markDirty(CoefficientDesigner::allStages);
 }
 
-void SimplePluginAudioProcessor::updateCoefficients(Coefficients& old, const Coefficients& replacements)
+void SimplePluginAudioProcessor::applyCoefficients(const ChainCoefficients& chainCoefficients, bool crossfade)
 {
-    *old = *replacements;
+    // A preset switch crossfades instead of gliding
+    eqSmoother.setTarget(chainCoefficients, crossfade);
+    svfChain.setTargets(chainCoefficients);
+
+    // Only the newly selected engine is cleared; the previous one still has to fade out
+    if (chainCoefficients.eqEngine != eqEngine)
+    {
+        fadingEqEngine = eqEngine;
+        eqEngine = chainCoefficients.eqEngine;
+        eqEngineFadePosition = 0;
+
+        if (eqEngine == EqEngine::StateVariable)
+        {
+            svfChain.reset();
+        }
+        else
+        {
+            eqSmoother.reset();
+            filterChain.reset();
+        }
+    }
+
+    filterChain.setCoefficients(eqSmoother.getCoefficients(), crossfade);
+
+    const auto& reverbParameters = chainCoefficients.reverb;
+
+    for (auto& pairReverb : reverbs)
+        pairReverb->setParameters(reverbParameters);
+    customReverb.setParameters(reverbParameters.roomSize, reverbParameters.damping, reverbParameters.wetLevel, reverbParameters.dryLevel);
+    convolutionGain.setTargetValue(reverbParameters.wetLevel);
+
+    dryGain.setTargetValue(chainCoefficients.dryLevel);
+    preDelay.setDelay(chainCoefficients.preDelaySeconds);
+
+    auto wasIdle = ! reverbActive && samplesUntilReverbIdle <= 0;
+    reverbActive = reverbParameters.wetLevel > 0.0f;
+
+    if (reverbActive)
+        samplesUntilReverbIdle = reverbFadeOutSamples;
+
+    auto wakesUp = wasIdle && reverbActive;
+
+    // Don't let an engine that was idle, or a wet path that was skipped, replay an old tail
+    if (chainCoefficients.reverbEngine != reverbEngine || wakesUp)
+    {
+        // A running engine hands over to the new one instead of being cut off;
+        // an idle one has nothing left to hand over
+        if (! wasIdle)
+        {
+            fadingReverbEngine = reverbEngine;
+            reverbEngineFadePosition = 0;
+        }
+
+        reverbEngine = chainCoefficients.reverbEngine;
+        resetReverbEngine(reverbEngine);
+    }
+
+    if (wakesUp)
+        preDelay.reset();
+
+    silenceDetector.setMinimumSilence(chainCoefficients.preDelaySeconds);
+    updateTailLength(chainCoefficients);
 }
 
-void SimplePluginAudioProcessor::updateReverbParameters(const ChainSettings& chainSettings)
+void SimplePluginAudioProcessor::updateTailLength(const ChainCoefficients& chainCoefficients) noexcept
 {
-    juce::dsp::Reverb::Parameters reverbParameters;
-    reverbParameters.roomSize = chainSettings.roomSize;
-    reverbParameters.damping = chainSettings.damping;
-    reverbParameters.wetLevel = chainSettings.mix;
-    reverbParameters.dryLevel = 1.0f - reverbParameters.wetLevel;
-    reverbParameters.freezeMode = 0.0f;
-    reverbParameters.width = 1.0f;
+    auto reverbTailSeconds = reverbEngine == ReverbEngine::Convolution ? (double) convolutionTailSamples / currentSampleRate
+                                                                      : chainCoefficients.reverbTailSeconds;
+
+    // Nothing rings on after the input at Mix 0; the EQ's own ringing is far shorter than any reverb tail
+    auto seconds = reverbActive ? (double) chainCoefficients.preDelaySeconds + reverbTailSeconds : 0.0;
 
-    reverb.setParameters(reverbParameters);
+    tailLengthSeconds.store(seconds, std::memory_order_relaxed);
+}
+
+void SimplePluginAudioProcessor::resetReverbEngine(ReverbEngine engine)
+{
+    switch (engine)
+    {
+        case ReverbEngine::FeedbackDelayNetwork:
+            customReverb.reset();
+            break;
+
+        case ReverbEngine::Convolution:
+            for (auto& convolution : convolutions)
+                convolution->reset();
+            break;
+
+        case ReverbEngine::Freeverb:
+        default:
+            for (auto& pairReverb : reverbs)
+                pairReverb->reset();
+            break;
+    }
 }
 
 //==============================================================================
@@ -9,47 +9,27 @@
 #pragma once
 
 #include <JuceHeader.h>
-
-enum Slope
-{
-    Slope_12,
-    Slope_24,
-    Slope_36,
-    Slope_48
-};
-
-struct ChainSettings
-{
-    //EQ
-    float peakFreq{ 0 }, peakGainInDecibels{ 0 }, peakQuality{ 1.f };
-    float lowCutFreq{ 0 }, highCutFreq{ 0 };
-    Slope lowCutSlope{ Slope::Slope_12 }, highCutSlope{ Slope::Slope_12 };
-
-    bool inputEqBypassed{ false };
-    bool lowCutBypassed{ false };
-    bool peakBypassed{ false };
-    bool HighCutBypassed{ false };
-
-    //Reverb
-    float mix{ 1.f };
-    float roomSize{ 0.5f };
-    float damping{ 0.5f };
-    float preDelay{ 1.f };
-    float low{ 0 };
-
-    bool AnalyzerEnabled { true };
-    
-
-};
-
-
-
-ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& apvts);
+#include "ChainSettings.h"
+#include "ParameterHandles.h"
+#include "PluginState.h"
+#include "PresetBank.h"
+#include "CoefficientDesigner.h"
+#include "CustomReverb.h"
+#include "PreDelay.h"
+#include "RealtimeSafety.h"
+#include "SharedResources.h"
+#include "SilenceDetector.h"
+#include "SpectrumAnalyzer.h"
+#include "StageProfiler.h"
+#include "ControlRateSmoother.h"
+#include "MultichannelFilterChain.h"
+#include "SvfFilterChain.h"
 
 //==============================================================================
 /**
 */
-class SimplePluginAudioProcessor  : public juce::AudioProcessor
+class SimplePluginAudioProcessor  : public juce::AudioProcessor,
+                                    private juce::AudioProcessorValueTreeState::Listener
                             #if JucePlugin_Enable_ARA
                              , public juce::AudioProcessorARAExtension
                             #endif
@@ -96,83 +76,170 @@ public:
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     juce::AudioProcessorValueTreeState apvts {*this, nullptr, "Paramaters", createParameterLayout() };
 
-    
+    // Loads an impulse response for the convolution engine on a background thread.
+    // The audio thread keeps using the previous one until the new one is ready.
+    void loadImpulseResponse(const juce::File& impulseResponseFile);
+
+    // Per-stage load of processBlock, read by the editor
+    StageProfiler& getProfiler() { return profiler; }
+
+    // Pre- and post-EQ spectrum, read by the editor
+    SpectrumAnalyzer& getAnalyzer() { return analyzer; }
+
+    // Source of the EQ coefficients the editor draws its response curve from, and of the redesign count
+    CoefficientDesigner& getDesigner() { return designer; }
+
+    // Samples between coefficient updates while the biquad EQ glides; any thread.
+    // The audio thread picks the new size up at the start of its next block.
+    void setControlBlockSize(int numSamples) noexcept { controlBlockSize.store(juce::jmax(1, numSamples), std::memory_order_relaxed); }
+    int getControlBlockSize() const noexcept { return controlBlockSize.load(std::memory_order_relaxed); }
+
+    // =======A/B Compare=======
+    // Stores the current settings into the active slot and switches to the other one.
+    // A slot that was never stored starts as a copy of the current settings.
+    void toggleCompareSlot();
+    PresetBank::CompareSlot getCompareSlot() const noexcept { return compareSlot; }
 
 
 private:
 
     // =================== DSP UNITS ===================
 
+    // =======Coefficient Handoff=======
+    // Designs coefficients off the audio thread; parameter changes only mark the affected stages dirty
+    CoefficientDesigner designer{ apvts };
+
+    void parameterChanged(const juce::String& parameterID, float newValue) override;
+
+    // =======Session State=======
+    // Indexed like ParameterIDs::all, resolved once in the constructor
+    std::array<juce::RangedAudioParameter*, PluginState::numParameters> stateParameters{};
+
+    // Set while a state or a preset is applied; host automation on another thread
+    // during that time is covered by the redesign that follows it
+    std::atomic<bool> isApplyingValues{ false };
+
+    ParameterValues getParameterValues() const;
+
+    // Sets every parameter as one batch, followed by a single redesign. With precomputed coefficients
+    // the audio thread switches to them on its next block, crossfading, without waiting for the designer.
+    void applyParameterValues(const ParameterValues& values, const ChainCoefficients* precomputed = nullptr);
+
+    // Copies a published coefficient set into the chain and the reverb without allocating
+    void applyCoefficients(const ChainCoefficients& chainCoefficients, bool crossfade = false);
+
+    // =======Presets=======
+    static ParameterValues getDefaultValues(juce::AudioProcessorValueTreeState& state);
+
+    PresetBank presetBank{ getDefaultValues(apvts) };
+    std::atomic<int> currentProgram{ 0 };
+    PresetBank::CompareSlot compareSlot{ PresetBank::slotA };
+
+    // Handed to the audio thread by applyParameterValues. Designer sets read before the preset's
+    // batch are stale once it is applied, so sets older than presetGeneration are dropped.
+    std::atomic<const ChainCoefficients*> pendingPreset{ nullptr };
+    std::atomic<uint32_t> pendingPresetGeneration{ 0 };
+    uint32_t presetGeneration{ 0 };
+
+    // Tail for the host, from the applied settings; written on the audio thread, read anywhere
+    void updateTailLength(const ChainCoefficients& chainCoefficients) noexcept;
+    std::atomic<double> tailLengthSeconds{ 0.0 };
+
+    // Rate passed to prepareToPlay; offline tools call it without setting the processor's own rate
+    double currentSampleRate{ 44100.0 };
+
     // =======EQ=======
-    // Enum to represent the positions of different processing stages in the chain
-    enum ChainPositions
-    {
-        LowCut,
-        Peak,
-        HighCut,
-        Reverb
-    };
-    
-    // Define Filter and ProcessorChain types for easier use
-    using Filter = juce::dsp::IIR::Filter<float>;
-    using CutFilter = juce::dsp::ProcessorChain<Filter, Filter, Filter, Filter>;
-    using MonoChain = juce::dsp::ProcessorChain<CutFilter, Filter, CutFilter>;
-    using Coefficients = Filter::CoefficientsPtr;
-
-    // Create left and right processing chains
-    MonoChain leftChain, rightChain;
-
-    // Function to update the peak filter with new chain settings
-    void updatePeakFilter(const ChainSettings& chainSettings);
-    
-    // Function to update filter coefficients
-    static void updateCoefficients(Coefficients& old, const Coefficients& replacements);
-
-    // Template function to update a specific filter stage in the chain
-    template<int Index, typename ChainType, typename CoefficientType>
-    void update(ChainType& chain, const CoefficientType& coefficients)
-    {
-        updateCoefficients(chain.template get<Index>().coefficients, coefficients[Index]);
-        chain.template setBypassed<Index>(false);
-    }
-
-    // Template function to update the low-cut filter stages based on the slope
-    template<typename ChainType, typename CoefficientType>
-    inline void updateCutFilter(ChainType& LowCut, const CoefficientType& cutCoefficients, const Slope& lowCutSlope)
-    {
-        // Initially bypass all filter stages
-        LowCut.template setBypassed<0>(true);
-        LowCut.template setBypassed<1>(true);
-        LowCut.template setBypassed<2>(true);
-        LowCut.template setBypassed<3>(true);
-
-        // Update the filter stages based on the low-cut slope
-        switch (lowCutSlope)
-        {
-            case Slope_48:
-            {
-                update<3>(LowCut, cutCoefficients);
-            }
-            case Slope_36:
-            {
-                update<2>(LowCut, cutCoefficients);
-            }
-            case Slope_24:
-            {
-                update<1>(LowCut, cutCoefficients);
-            }
-            case Slope_12:
-            {
-                update<0>(LowCut, cutCoefficients);
-            }
-        }
-    }
+    // Low cut, peak and high cut for every channel, with the channels packed into SIMD lanes
+    MultichannelFilterChain filterChain;
+
+    // Glides filterChain to new settings at a fixed control rate, whatever the host's block size
+    ControlRateSmoother eqSmoother;
+    std::atomic<int> controlBlockSize{ SIMPLEPLUGIN_CONTROL_BLOCK_SIZE };
+
+    // The same stages as state-variable filters whose settings glide sample by sample; runs instead of
+    // filterChain when selected. The newly selected engine starts from silence, so after a switch the
+    // previous one keeps running on a copy of the block and fades out over eqEngineFadeSeconds.
+    SvfFilterChain svfChain;
+    EqEngine eqEngine{ EqEngine::Biquad }, fadingEqEngine{ EqEngine::Biquad };
+    juce::AudioBuffer<float> fadingEqBuffer;
+
+    // Separate from the reverb fades, so tuning those leaves the EQ switch alone
+    static constexpr double eqEngineFadeSeconds = 0.05;
+    int eqEngineFadeSamples{ 1 };
+    int eqEngineFadePosition{ 0 };
+
+    // Runs the selected engine, crossfaded with the previous one for a while after a switch
+    void processEqualiser(juce::dsp::AudioBlock<float>& block) noexcept;
+    void runEqEngine(EqEngine engine, juce::dsp::AudioBlock<float>& block) noexcept;
 
 
     //=======Reverb=======
-    juce::dsp::Reverb reverb;
+    // Only the wet path goes through the pre-delay and the reverb; it is rendered into wetBuffer
+    // while the dry signal stays in the host buffer, and the two are summed at the end
+    PreDelay preDelay;
+    juce::AudioBuffer<float> wetBuffer;
+    juce::SmoothedValue<float> dryGain, convolutionGain;
+
+    // Freeverb and the convolution are stereo engines, so wider layouts run one of each per channel pair.
+    // Both banks are sized in prepareToPlay; the FDN handles any channel count by itself.
+    std::vector<std::unique_ptr<juce::dsp::Reverb>> reverbs;
+    CustomReverb customReverb;
+
+    // Non-uniform partitioning: a short zero-latency head followed by larger FFT partitions for the tail
+    static constexpr int convolutionHeadSize = 256;
+
+    // One loader thread for the whole bank, however many pairs there are
+    juce::dsp::ConvolutionMessageQueue convolutionQueue;
+    std::vector<std::unique_ptr<juce::dsp::Convolution>> convolutions;
+
+    // Every engine decodes and partitions the file itself; the decoded audio is freed once it is loaded
+    static void loadImpulseResponse(juce::dsp::Convolution& convolution, const juce::File& impulseResponseFile);
+
+    // Path of the loaded impulse response, kept in the parameter state
+    static constexpr const char* impulseResponseProperty = "ImpulseResponse";
+
+    ReverbEngine reverbEngine{ ReverbEngine::Freeverb };
+
+    // After a switch the previous engine keeps running on its own copy of the wet signal and fades out
+    // over reverbFadeOutSamples while the new one fades in, so neither tail is cut off
+    ReverbEngine fadingReverbEngine{ ReverbEngine::Freeverb };
+    juce::AudioBuffer<float> fadingWetBuffer;
+    int reverbEngineFadePosition{ 0 };
+
+    // Pre-delay, reverb and dry/wet mix, in chunks of at most the wet buffer's prepared size
+    void processReverb(juce::dsp::AudioBlock<float>& block) noexcept;
+    void processReverbChunk(juce::dsp::AudioBlock<float>& block) noexcept;
+
+    // Runs one engine over the wet block in place
+    void runReverbEngine(ReverbEngine engine, juce::dsp::AudioBlock<float>& wetBlock) noexcept;
+
+    // Clears the tail of one engine
+    void resetReverbEngine(ReverbEngine engine);
+
+    // Length of the loaded impulse response, polled on the audio thread since it loads in the background
+    int convolutionTailSamples{ 0 };
+
+    // At Mix 0 the wet path keeps running until every wet gain has ramped down, then the
+    // pre-delay and reverb are skipped and only the dry gain is applied until the mix is raised again
+    static constexpr double reverbFadeOutSeconds = 0.1;
+    int reverbFadeOutSamples{ 0 };
+    int samplesUntilReverbIdle{ 0 };
+    bool reverbActive{ true };
+
+
+    //=======Idle Mode=======
+    // Skips the whole chain on silent input once the tail has decayed
+    SilenceDetector silenceDetector;
+
+
+    //=======Profiling=======
+    StageProfiler profiler;
+    StageProfiler::Snapshot profileAtPrepare;
+
 
-    void updateReverbParameters(const ChainSettings& chainSettings);
+    //=======Analyzer=======
+    // Taps the signal around the EQ; idle unless enabled and an editor is open
+    SpectrumAnalyzer analyzer;
 
 
     //==============================================================================
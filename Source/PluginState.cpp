@@ -0,0 +1,211 @@
+/*
+  ==============================================================================
+
+    PluginState.cpp
+
+  ==============================================================================
+*/
+
+#include "PluginState.h"
+
+namespace
+{
+    // Bounds-checked little-endian reads straight from the caller's memory
+    class Reader
+    {
+    public:
+        Reader(const void* data, size_t sizeInBytes) noexcept
+            : position(static_cast<const char*>(data)), end(position + sizeInBytes)
+        {
+        }
+
+        size_t getRemaining() const noexcept { return (size_t) (end - position); }
+
+        bool readUint8(juce::uint8& value) noexcept
+        {
+            if (getRemaining() < 1)
+                return false;
+
+            value = (juce::uint8) *position++;
+            return true;
+        }
+
+        bool readUint16(juce::uint16& value) noexcept
+        {
+            if (getRemaining() < 2)
+                return false;
+
+            value = juce::ByteOrder::littleEndianShort(position);
+            position += 2;
+            return true;
+        }
+
+        bool readUint32(juce::uint32& value) noexcept
+        {
+            if (getRemaining() < 4)
+                return false;
+
+            value = juce::ByteOrder::littleEndianInt(position);
+            position += 4;
+            return true;
+        }
+
+        bool readFloat(float& value) noexcept
+        {
+            juce::uint32 bits;
+
+            if (! readUint32(bits))
+                return false;
+
+            std::memcpy(&value, &bits, sizeof(value));
+            return true;
+        }
+
+        bool readBytes(size_t numBytes, const char*& bytes) noexcept
+        {
+            if (getRemaining() < numBytes)
+                return false;
+
+            bytes = position;
+            position += numBytes;
+            return true;
+        }
+
+    private:
+        const char* position;
+        const char* const end;
+    };
+
+    // Index into ParameterIDs::all, or -1. Parameters are written in that order, so the
+    // expected index is tried first and a full search only happens for reordered states.
+    int findParameter(const char* id, size_t length, size_t expectedIndex) noexcept
+    {
+        auto matches = [id, length](size_t index)
+        {
+            const auto* candidate = ParameterIDs::all[index];
+            return std::strlen(candidate) == length && std::memcmp(candidate, id, length) == 0;
+        };
+
+        if (expectedIndex < PluginState::numParameters && matches(expectedIndex))
+            return (int) expectedIndex;
+
+        for (size_t index = 0; index < PluginState::numParameters; ++index)
+            if (matches(index))
+                return (int) index;
+
+        return -1;
+    }
+
+    bool readParameters(Reader& reader, PluginState::Contents& contents)
+    {
+        juce::uint16 count;
+
+        if (! reader.readUint16(count))
+            return false;
+
+        for (size_t entry = 0; entry < count; ++entry)
+        {
+            juce::uint8 idLength;
+            const char* id;
+            float value;
+
+            if (! reader.readUint8(idLength) || ! reader.readBytes(idLength, id) || ! reader.readFloat(value))
+                return false;
+
+            // Parameters this build doesn't have any more are dropped
+            auto index = findParameter(id, idLength, entry);
+
+            if (index >= 0)
+            {
+                contents.values[(size_t) index] = value;
+                contents.hasValue[(size_t) index] = true;
+            }
+        }
+
+        return true;
+    }
+}
+
+namespace PluginState
+{
+    void write(const Contents& contents, juce::MemoryBlock& dest)
+    {
+        juce::MemoryOutputStream parameters;
+        parameters.writeShort((short) numParameters);
+
+        for (size_t index = 0; index < numParameters; ++index)
+        {
+            const auto* id = ParameterIDs::all[index];
+            auto idLength = std::strlen(id);
+
+            // IDs are stored with a one byte length
+            jassert(idLength <= 255);
+
+            parameters.writeByte((char) idLength);
+            parameters.write(id, idLength);
+            parameters.writeFloat(contents.values[index]);
+        }
+
+        auto impulseResponsePath = contents.impulseResponsePath.toUTF8();
+        auto impulseResponsePathSize = impulseResponsePath.sizeInBytes() - 1;
+
+        juce::MemoryOutputStream stream(dest, false);
+        stream.writeInt((int) magic);
+        stream.writeShort((short) currentVersion);
+
+        stream.writeByte((char) parametersSection);
+        stream.writeInt((int) parameters.getDataSize());
+        stream.write(parameters.getData(), parameters.getDataSize());
+
+        stream.writeByte((char) impulseResponseSection);
+        stream.writeInt((int) impulseResponsePathSize);
+        stream.write(impulseResponsePath.getAddress(), impulseResponsePathSize);
+    }
+
+    bool read(const void* data, size_t sizeInBytes, Contents& contents)
+    {
+        Reader reader(data, sizeInBytes);
+
+        juce::uint32 stateMagic;
+        juce::uint16 version;
+
+        if (! reader.readUint32(stateMagic) || stateMagic != magic || ! reader.readUint16(version))
+            return false;
+
+        contents = {};
+
+        // Every version so far shares the section layout; a later one that changes a section's
+        // payload gets a new tag, so older sections keep their meaning
+        juce::ignoreUnused(version);
+
+        while (reader.getRemaining() > 0)
+        {
+            juce::uint8 tag;
+            juce::uint32 size;
+            const char* payload;
+
+            if (! reader.readUint8(tag) || ! reader.readUint32(size) || ! reader.readBytes(size, payload))
+                return false;
+
+            Reader section(payload, size);
+
+            switch (tag)
+            {
+                case parametersSection:
+                    if (! readParameters(section, contents))
+                        return false;
+                    break;
+
+                case impulseResponseSection:
+                    contents.impulseResponsePath = juce::String::fromUTF8(payload, (int) size);
+                    break;
+
+                default:
+                    // Written by a newer version; skipped
+                    break;
+            }
+        }
+
+        return true;
+    }
+}
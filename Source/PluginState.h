@@ -0,0 +1,56 @@
+/*
+  ==============================================================================
+
+    PluginState.h
+
+    Compact binary session state. Little-endian throughout:
+
+        uint32  magic 'SPst'
+        uint16  format version
+        then tagged sections until the end of the data:
+            uint8   tag
+            uint32  payload size in bytes
+            payload
+
+    The parameter section holds a uint16 count followed by, per parameter,
+    a uint8 ID length, the ID's UTF-8 bytes and the plain (denormalised)
+    value as a float32. Values are keyed by their stable parameter IDs, so
+    reordering, adding or removing parameters never breaks a saved session.
+    Readers skip sections they don't know by their size, and parameters a
+    state doesn't contain fall back to their defaults.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ParameterHandles.h"
+
+namespace PluginState
+{
+    inline constexpr juce::uint32 magic = 0x74735053; // "SPst" in file order
+    inline constexpr int currentVersion = 1;
+
+    enum SectionTag : juce::uint8
+    {
+        parametersSection = 1,
+        impulseResponseSection = 2
+    };
+
+    inline constexpr size_t numParameters = ParameterIDs::all.size();
+
+    // Everything a session stores, with the parameters indexed like ParameterIDs::all
+    struct Contents
+    {
+        ParameterValues values{};
+        std::array<bool, numParameters> hasValue{};
+        juce::String impulseResponsePath;
+    };
+
+    void write(const Contents& contents, juce::MemoryBlock& dest);
+
+    // Parses data written by any version of write(). Returns false, leaving contents
+    // in an unspecified state, if the data isn't a state or is truncated.
+    bool read(const void* data, size_t sizeInBytes, Contents& contents);
+}
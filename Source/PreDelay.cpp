@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    PreDelay.cpp
+
+  ==============================================================================
+*/
+
+#include "PreDelay.h"
+
+void PreDelay::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    sampleRate = spec.sampleRate;
+    numChannels = (int) spec.numChannels;
+
+    // One extra sample for the interpolation partner of the longest delay
+    channelSize = juce::nextPowerOfTwo((int) std::ceil(maxDelaySeconds * sampleRate) + 2);
+    channelMask = channelSize - 1;
+
+    ring.assign((size_t) (channelSize * numChannels), 0.0f);
+
+    sources.resize((size_t) numChannels);
+    destinations.resize((size_t) numChannels);
+    lines.resize((size_t) numChannels);
+
+    delayInSamples.reset(sampleRate, smoothingSeconds);
+    reset();
+}
+
+void PreDelay::reset() noexcept
+{
+    std::fill(ring.begin(), ring.end(), 0.0f);
+    writePosition = 0;
+
+    delayInSamples.setCurrentAndTargetValue(delayInSamples.getTargetValue());
+}
+
+void PreDelay::setDelay(float delaySeconds) noexcept
+{
+    delayInSamples.setTargetValue(juce::jlimit(0.0f, maxDelaySeconds, delaySeconds) * (float) sampleRate);
+}
+
+//==============================================================================
+void PreDelay::process(const juce::dsp::AudioBlock<const float>& input, juce::dsp::AudioBlock<float>& output) noexcept
+{
+    auto channelsToProcess = (int) input.getNumChannels();
+    auto numSamples = input.getNumSamples();
+
+    jassert(channelsToProcess <= numChannels);
+    jassert(output.getNumChannels() == input.getNumChannels() && output.getNumSamples() == numSamples);
+
+    channelsToProcess = juce::jmin(channelsToProcess, numChannels);
+
+    for (int channel = 0; channel < channelsToProcess; ++channel)
+    {
+        sources[(size_t) channel] = input.getChannelPointer((size_t) channel);
+        destinations[(size_t) channel] = output.getChannelPointer((size_t) channel);
+        lines[(size_t) channel] = ring.data() + channel * channelSize;
+    }
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        auto readPosition = (float) writePosition - delayInSamples.getNextValue();
+        auto integerPart = (int) std::floor(readPosition);
+        auto fraction = readPosition - (float) integerPart;
+
+        for (int channel = 0; channel < channelsToProcess; ++channel)
+        {
+            auto* line = lines[(size_t) channel];
+
+            // Written first, so a zero delay passes the current sample straight through
+            line[writePosition] = sources[(size_t) channel][i];
+
+            auto a = line[integerPart & channelMask];
+            auto b = line[(integerPart + 1) & channelMask];
+
+            destinations[(size_t) channel][i] = a + fraction * (b - a);
+        }
+
+        writePosition = (writePosition + 1) & channelMask;
+    }
+}
@@ -0,0 +1,53 @@
+/*
+  ==============================================================================
+
+    PreDelay.h
+
+    Fractional delay in front of the reverb. Each channel owns a power-of-two
+    region of one ring buffer that is sized once in prepare() for the longest
+    delay, so changing the delay only moves the read position.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+class PreDelay
+{
+public:
+    static constexpr float maxDelaySeconds = 0.5f;
+
+    PreDelay() = default;
+
+    // Allocates the ring buffer for maxDelaySeconds at spec.sampleRate, for spec.numChannels channels
+    void prepare(const juce::dsp::ProcessSpec& spec);
+    void reset() noexcept;
+
+    // The delay glides to the new value, which bends the pitch briefly instead of clicking
+    void setDelay(float delaySeconds) noexcept;
+
+    // Writes input into the ring and the delayed signal into output; never allocates.
+    // Both blocks need the same size, and at most as many channels as were prepared.
+    void process(const juce::dsp::AudioBlock<const float>& input, juce::dsp::AudioBlock<float>& output) noexcept;
+
+private:
+    static constexpr double smoothingSeconds = 0.05;
+
+    std::vector<float> ring;
+
+    // Per-channel pointers, filled in by process() without allocating
+    std::vector<const float*> sources;
+    std::vector<float*> destinations, lines;
+
+    int numChannels{ 0 };
+    int channelSize{ 0 };
+    int channelMask{ 0 };
+    int writePosition{ 0 };
+
+    double sampleRate{ 44100.0 };
+    juce::SmoothedValue<float> delayInSamples;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PreDelay)
+};
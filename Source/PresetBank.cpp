@@ -0,0 +1,140 @@
+/*
+  ==============================================================================
+
+    PresetBank.cpp
+
+  ==============================================================================
+*/
+
+#include "PresetBank.h"
+
+namespace
+{
+    struct FactoryProgram
+    {
+        const char* name;
+        std::vector<std::pair<const char*, float>> values;
+    };
+
+    // Plain values; anything a program doesn't list keeps its default. Choices are indices.
+    const std::array<FactoryProgram, 6> factoryPrograms
+    {{
+        { "Init", {} },
+
+        { "Small Room", { { ParameterIDs::lowCutFreq, 80.0f },
+                          { ParameterIDs::roomSize, 0.25f }, { ParameterIDs::damping, 0.6f },
+                          { ParameterIDs::mix, 0.25f }, { ParameterIDs::preDelay, 5.0f } } },
+
+        { "Vocal Plate", { { ParameterIDs::lowCutFreq, 150.0f }, { ParameterIDs::lowCutSlope, 1.0f },
+                           { ParameterIDs::peakFreq, 3000.0f }, { ParameterIDs::peakGain, 2.0f }, { ParameterIDs::peakQuality, 0.8f },
+                           { ParameterIDs::reverbEngine, (float) ReverbEngine::FeedbackDelayNetwork },
+                           { ParameterIDs::roomSize, 0.55f }, { ParameterIDs::damping, 0.35f },
+                           { ParameterIDs::mix, 0.3f }, { ParameterIDs::preDelay, 25.0f } } },
+
+        { "Large Hall", { { ParameterIDs::lowCutFreq, 60.0f }, { ParameterIDs::highCutFreq, 12000.0f },
+                          { ParameterIDs::roomSize, 0.85f }, { ParameterIDs::damping, 0.5f },
+                          { ParameterIDs::mix, 0.4f }, { ParameterIDs::preDelay, 40.0f } } },
+
+        { "Telephone", { { ParameterIDs::lowCutFreq, 400.0f }, { ParameterIDs::lowCutSlope, 3.0f },
+                         { ParameterIDs::highCutFreq, 3400.0f }, { ParameterIDs::highCutSlope, 3.0f },
+                         { ParameterIDs::peakFreq, 1500.0f }, { ParameterIDs::peakGain, 6.0f }, { ParameterIDs::peakQuality, 1.2f },
+                         { ParameterIDs::mix, 0.0f } } },
+
+        { "Dark Ambience", { { ParameterIDs::highCutFreq, 6000.0f }, { ParameterIDs::highCutSlope, 1.0f },
+                             { ParameterIDs::reverbEngine, (float) ReverbEngine::FeedbackDelayNetwork },
+                             { ParameterIDs::roomSize, 0.95f }, { ParameterIDs::damping, 0.8f },
+                             { ParameterIDs::mix, 0.6f }, { ParameterIDs::preDelay, 60.0f } } }
+    }};
+}
+
+PresetBank::PresetBank(const ParameterValues& defaultValues)
+    : defaults(defaultValues)
+{
+    for (const auto& factoryProgram : factoryPrograms)
+        programNames.push_back(factoryProgram.name);
+
+    prepare(sampleRate);
+}
+
+size_t PresetBank::Programs::getSizeInBytes() const noexcept
+{
+    return sizeof(*this) + entries.capacity() * sizeof(Entry);
+}
+
+//==============================================================================
+void PresetBank::prepare(double newSampleRate)
+{
+    sampleRate = newSampleRate;
+
+    programs = SharedResources::get<Programs>("PresetBank/Programs/" + juce::String(sampleRate), [this]
+    {
+        auto designed = std::make_shared<Programs>();
+
+        for (const auto& factoryProgram : factoryPrograms)
+        {
+            Entry entry;
+            entry.name = factoryProgram.name;
+            entry.values = defaults;
+
+            for (const auto& [parameterID, value] : factoryProgram.values)
+            {
+                auto index = ParameterIDs::indexOf(parameterID);
+                jassert(index < entry.values.size());
+
+                entry.values[index] = value;
+            }
+
+            designEntry(entry, sampleRate);
+            designed->entries.push_back(std::move(entry));
+        }
+
+        return designed;
+    });
+
+    for (auto& slot : compareSlots)
+        if (slot.current.load() >= 0)
+            for (auto& half : slot.halves)
+                designEntry(half, sampleRate);
+}
+
+void PresetBank::designEntry(Entry& entry, double sampleRate)
+{
+    CoefficientDesigner::design(entry.coefficients, ParameterHandles::load(entry.values), sampleRate, CoefficientDesigner::allStages);
+}
+
+const PresetBank::Entry& PresetBank::getProgram(int index) const noexcept
+{
+    jassert(juce::isPositiveAndBelow(index, getNumPrograms()));
+    return programs->entries[(size_t) juce::jlimit(0, getNumPrograms() - 1, index)];
+}
+
+const juce::String& PresetBank::getProgramName(int index) const noexcept
+{
+    jassert(juce::isPositiveAndBelow(index, getNumPrograms()));
+    return programNames[(size_t) juce::jlimit(0, getNumPrograms() - 1, index)];
+}
+
+void PresetBank::setProgramName(int index, const juce::String& newName)
+{
+    if (juce::isPositiveAndBelow(index, getNumPrograms()))
+        programNames[(size_t) index] = newName;
+}
+
+//==============================================================================
+void PresetBank::storeCompareSlot(CompareSlot slot, const ParameterValues& values)
+{
+    auto& compareSlot = compareSlots[(size_t) slot];
+    auto& half = compareSlot.halves[compareSlot.current.load() == 0 ? 1 : 0];
+
+    half.name = slot == slotA ? "A" : "B";
+    half.values = values;
+    designEntry(half, sampleRate);
+
+    compareSlot.current.store(&half == &compareSlot.halves[0] ? 0 : 1);
+}
+
+const PresetBank::Entry* PresetBank::getCompareSlot(CompareSlot slot) const noexcept
+{
+    auto current = compareSlots[(size_t) slot].current.load();
+    return current >= 0 ? &compareSlots[(size_t) slot].halves[(size_t) current] : nullptr;
+}
@@ -0,0 +1,87 @@
+/*
+  ==============================================================================
+
+    PresetBank.h
+
+    The factory programs and the two A/B compare slots. Every entry keeps
+    its parameter values together with coefficients designed ahead of time
+    for the prepared sample rate, so switching to an entry on the audio
+    thread only hands over a pointer to a finished set.
+
+    The factory programs are the same for every instance, so their designs
+    are shared through SharedResources, one set per sample rate; only the
+    program names an instance renames are its own. Entries never move while
+    the bank holds them. The compare slots are double buffered: storing
+    into a slot designs into the half the audio thread isn't pointed at,
+    then flips the slot over.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "CoefficientDesigner.h"
+#include "SharedResources.h"
+
+class PresetBank
+{
+public:
+    struct Entry
+    {
+        juce::String name;
+        ParameterValues values{};
+        ChainCoefficients coefficients;
+    };
+
+    enum CompareSlot
+    {
+        slotA,
+        slotB,
+        numCompareSlots
+    };
+
+    // Builds the factory programs on top of the parameter defaults, which are the same for every instance
+    explicit PresetBank(const ParameterValues& defaults);
+
+    // =======Message thread=======
+    // Switches to the programs designed for the new sample rate and redesigns the compare slots;
+    // the audio thread must not be running
+    void prepare(double newSampleRate);
+
+    int getNumPrograms() const noexcept { return (int) programNames.size(); }
+    const Entry& getProgram(int index) const noexcept;
+
+    const juce::String& getProgramName(int index) const noexcept;
+    void setProgramName(int index, const juce::String& newName);
+
+    // Designs the values into the slot before returning
+    void storeCompareSlot(CompareSlot slot, const ParameterValues& values);
+    const Entry* getCompareSlot(CompareSlot slot) const noexcept;
+
+private:
+    static void designEntry(Entry& entry, double sampleRate);
+
+    struct Programs
+    {
+        size_t getSizeInBytes() const noexcept;
+
+        std::vector<Entry> entries;
+    };
+
+    ParameterValues defaults;
+    double sampleRate{ 44100.0 };
+
+    std::shared_ptr<const Programs> programs;
+    std::vector<juce::String> programNames;
+
+    struct DoubleBufferedEntry
+    {
+        std::array<Entry, 2> halves;
+        std::atomic<int> current{ -1 };  // -1 until the slot is first stored
+    };
+
+    std::array<DoubleBufferedEntry, numCompareSlots> compareSlots;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PresetBank)
+};
@@ -0,0 +1,292 @@
+/*
+  ==============================================================================
+
+    RealtimeSafety.cpp
+
+    Replaces the global allocation functions and pthread_mutex_lock. In an
+    executable (standalone, render tool, benchmarks) this covers the whole
+    process; in a plugin built with hidden symbols it covers the plugin's
+    own code.
+
+  ==============================================================================
+*/
+
+#include "RealtimeSafety.h"
+
+#if SIMPLEPLUGIN_REALTIME_CHECKS
+
+#include <cerrno>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+// glibc's own allocator entry points, so the replacements below don't call themselves
+extern "C"
+{
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t count, size_t size);
+    void* __libc_realloc(void* pointer, size_t size);
+    void* __libc_memalign(size_t alignment, size_t size);
+    void* __libc_valloc(size_t size);
+    void* __libc_pvalloc(size_t size);
+    void __libc_free(void* pointer);
+}
+
+namespace RealtimeSafety
+{
+    namespace
+    {
+        enum class Violation
+        {
+            allocation,
+            deallocation,
+            mutexLock
+        };
+
+        // The initial-exec model never allocates on first access, unlike the default model in a shared library
+        __attribute__((tls_model("initial-exec"))) thread_local int realtimeDepth = 0;
+        __attribute__((tls_model("initial-exec"))) thread_local bool isReporting = false;
+
+        std::atomic<juce::uint64> allocations{ 0 }, deallocations{ 0 }, mutexLocks{ 0 };
+        std::atomic<bool> abortOnViolation{ false };
+
+        using MutexLockFunction = int (*)(pthread_mutex_t*);
+        std::atomic<MutexLockFunction> realMutexLock{ nullptr };
+
+        MutexLockFunction getRealMutexLock() noexcept
+        {
+            auto function = realMutexLock.load(std::memory_order_relaxed);
+
+            if (function == nullptr)
+            {
+                function = reinterpret_cast<MutexLockFunction>(dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+                realMutexLock.store(function, std::memory_order_relaxed);
+            }
+
+            return function;
+        }
+
+        // backtrace() loads libgcc and dlsym() may allocate on first use, so both happen before any audio thread runs
+        struct Initialiser
+        {
+            Initialiser()
+            {
+                void* frames[1];
+                backtrace(frames, 1);
+                getRealMutexLock();
+
+                if (auto* value = std::getenv("SIMPLEPLUGIN_REALTIME_ABORT"))
+                    abortOnViolation = value[0] == '1';
+            }
+        };
+
+        Initialiser initialiser;
+
+        std::atomic<juce::uint64>& getCounter(Violation violation) noexcept
+        {
+            switch (violation)
+            {
+                case Violation::allocation:   return allocations;
+                case Violation::deallocation: return deallocations;
+                case Violation::mutexLock:
+                default:                      return mutexLocks;
+            }
+        }
+
+        // Only uses write() and backtrace_symbols_fd(), neither of which allocates
+        void report(Violation violation, const char* function) noexcept
+        {
+            auto count = getCounter(violation).fetch_add(1, std::memory_order_relaxed) + 1;
+
+            isReporting = true;
+
+            char message[160];
+            auto length = std::snprintf(message, sizeof(message), "*** Real-time violation: %s on the audio thread (#%llu)\n",
+                                        function, (unsigned long long) count);
+
+            if (length > 0)
+                juce::ignoreUnused(::write(STDERR_FILENO, message, (size_t) juce::jmin(length, (int) sizeof(message) - 1)));
+
+            void* frames[64];
+            backtrace_symbols_fd(frames, backtrace(frames, 64), STDERR_FILENO);
+
+            isReporting = false;
+
+            if (abortOnViolation.load(std::memory_order_relaxed))
+                std::abort();
+        }
+
+        inline void check(Violation violation, const char* function) noexcept
+        {
+            if (realtimeDepth > 0 && ! isReporting)
+                report(violation, function);
+        }
+    }
+
+    //==============================================================================
+    void setFailureMode(FailureMode mode) noexcept
+    {
+        abortOnViolation = mode == FailureMode::abort;
+    }
+
+    ViolationCount getViolationCount() noexcept
+    {
+        return { allocations.load(), deallocations.load(), mutexLocks.load() };
+    }
+
+    void resetViolationCount() noexcept
+    {
+        allocations = 0;
+        deallocations = 0;
+        mutexLocks = 0;
+    }
+
+    ScopedRealtimeContext::ScopedRealtimeContext() noexcept
+    {
+        ++realtimeDepth;
+    }
+
+    ScopedRealtimeContext::~ScopedRealtimeContext() noexcept
+    {
+        --realtimeDepth;
+    }
+}
+
+//==============================================================================
+using RealtimeSafety::Violation;
+
+extern "C"
+{
+    void* malloc(size_t size) noexcept
+    {
+        RealtimeSafety::check(Violation::allocation, "malloc");
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t count, size_t size) noexcept
+    {
+        RealtimeSafety::check(Violation::allocation, "calloc");
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* pointer, size_t size) noexcept
+    {
+        RealtimeSafety::check(Violation::allocation, "realloc");
+        return __libc_realloc(pointer, size);
+    }
+
+    // Aligned entry points, reached by HeapBlock, SIMD buffers and libstdc++'s aligned operator new
+    int posix_memalign(void** result, size_t alignment, size_t size) noexcept
+    {
+        RealtimeSafety::check(Violation::allocation, "posix_memalign");
+
+        if (alignment == 0 || alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0)
+            return EINVAL;
+
+        auto* pointer = __libc_memalign(alignment, size);
+
+        if (pointer == nullptr)
+            return ENOMEM;
+
+        *result = pointer;
+        return 0;
+    }
+
+    void* aligned_alloc(size_t alignment, size_t size) noexcept
+    {
+        RealtimeSafety::check(Violation::allocation, "aligned_alloc");
+        return __libc_memalign(alignment, size);
+    }
+
+    void* memalign(size_t alignment, size_t size) noexcept
+    {
+        RealtimeSafety::check(Violation::allocation, "memalign");
+        return __libc_memalign(alignment, size);
+    }
+
+    void* valloc(size_t size) noexcept
+    {
+        RealtimeSafety::check(Violation::allocation, "valloc");
+        return __libc_valloc(size);
+    }
+
+    void* pvalloc(size_t size) noexcept
+    {
+        RealtimeSafety::check(Violation::allocation, "pvalloc");
+        return __libc_pvalloc(size);
+    }
+
+    void free(void* pointer) noexcept
+    {
+        if (pointer != nullptr)
+            RealtimeSafety::check(Violation::deallocation, "free");
+
+        __libc_free(pointer);
+    }
+
+    int pthread_mutex_lock(pthread_mutex_t* mutex) noexcept
+    {
+        RealtimeSafety::check(Violation::mutexLock, "pthread_mutex_lock");
+        return RealtimeSafety::getRealMutexLock()(mutex);
+    }
+}
+
+namespace
+{
+    void* allocate(size_t size, const char* function) noexcept
+    {
+        RealtimeSafety::check(Violation::allocation, function);
+        return __libc_malloc(size == 0 ? 1 : size);
+    }
+
+    void* allocateAligned(size_t size, std::align_val_t alignment, const char* function) noexcept
+    {
+        RealtimeSafety::check(Violation::allocation, function);
+        return __libc_memalign((size_t) alignment, size == 0 ? 1 : size);
+    }
+
+    void deallocate(void* pointer, const char* function) noexcept
+    {
+        if (pointer != nullptr)
+            RealtimeSafety::check(Violation::deallocation, function);
+
+        __libc_free(pointer);
+    }
+
+    template <typename Pointer>
+    Pointer throwIfNull(Pointer pointer)
+    {
+        if (pointer == nullptr)
+            throw std::bad_alloc();
+
+        return pointer;
+    }
+}
+
+void* operator new(size_t size)                                                  { return throwIfNull(allocate(size, "operator new")); }
+void* operator new[](size_t size)                                                { return throwIfNull(allocate(size, "operator new[]")); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept                  { return allocate(size, "operator new"); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept                { return allocate(size, "operator new[]"); }
+void* operator new(size_t size, std::align_val_t alignment)                      { return throwIfNull(allocateAligned(size, alignment, "operator new")); }
+void* operator new[](size_t size, std::align_val_t alignment)                    { return throwIfNull(allocateAligned(size, alignment, "operator new[]")); }
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept   { return allocateAligned(size, alignment, "operator new"); }
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return allocateAligned(size, alignment, "operator new[]"); }
+
+void operator delete(void* pointer) noexcept                                     { deallocate(pointer, "operator delete"); }
+void operator delete[](void* pointer) noexcept                                   { deallocate(pointer, "operator delete[]"); }
+void operator delete(void* pointer, size_t) noexcept                             { deallocate(pointer, "operator delete"); }
+void operator delete[](void* pointer, size_t) noexcept                           { deallocate(pointer, "operator delete[]"); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept              { deallocate(pointer, "operator delete"); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept            { deallocate(pointer, "operator delete[]"); }
+void operator delete(void* pointer, std::align_val_t) noexcept                   { deallocate(pointer, "operator delete"); }
+void operator delete[](void* pointer, std::align_val_t) noexcept                 { deallocate(pointer, "operator delete[]"); }
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept           { deallocate(pointer, "operator delete"); }
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept         { deallocate(pointer, "operator delete[]"); }
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept   { deallocate(pointer, "operator delete"); }
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { deallocate(pointer, "operator delete[]"); }
+
+#endif
@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+    RealtimeSafety.h
+
+    Debug check that nothing on the audio thread allocates, frees or locks a
+    mutex. While a ScopedRealtimeContext is alive on a thread, every call to
+    operator new/delete, malloc/calloc/realloc/free, the aligned allocators
+    (posix_memalign, aligned_alloc, memalign, valloc, pvalloc) and
+    pthread_mutex_lock from that thread is counted and logged to stderr with a backtrace, or
+    aborts the process in FailureMode::abort.
+
+    Enabled by default in Linux debug builds; define
+    SIMPLEPLUGIN_REALTIME_CHECKS=0 or 1 to override. With the checks off
+    everything here compiles to nothing.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#ifndef SIMPLEPLUGIN_REALTIME_CHECKS
+ #define SIMPLEPLUGIN_REALTIME_CHECKS (JUCE_DEBUG && JUCE_LINUX)
+#endif
+
+#if SIMPLEPLUGIN_REALTIME_CHECKS && ! JUCE_LINUX
+ #error "The real-time safety checks intercept glibc and pthreads and are only available on Linux"
+#endif
+
+namespace RealtimeSafety
+{
+    enum class FailureMode
+    {
+        log,    // Count and print a backtrace, then carry on
+        abort   // Print a backtrace and abort, for tests
+    };
+
+    struct ViolationCount
+    {
+        juce::uint64 allocations{ 0 };
+        juce::uint64 deallocations{ 0 };
+        juce::uint64 mutexLocks{ 0 };
+
+        juce::uint64 getTotal() const noexcept { return allocations + deallocations + mutexLocks; }
+    };
+
+   #if SIMPLEPLUGIN_REALTIME_CHECKS
+    constexpr bool isEnabled = true;
+
+    // Also set to abort by the environment variable SIMPLEPLUGIN_REALTIME_ABORT=1
+    void setFailureMode(FailureMode mode) noexcept;
+
+    ViolationCount getViolationCount() noexcept;
+    void resetViolationCount() noexcept;
+
+    // Marks the current thread as real-time for its lifetime; may be nested
+    class ScopedRealtimeContext
+    {
+    public:
+        ScopedRealtimeContext() noexcept;
+        ~ScopedRealtimeContext() noexcept;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedRealtimeContext)
+    };
+   #else
+    constexpr bool isEnabled = false;
+
+    inline void setFailureMode(FailureMode) noexcept {}
+
+    inline ViolationCount getViolationCount() noexcept { return {}; }
+    inline void resetViolationCount() noexcept {}
+
+    class ScopedRealtimeContext
+    {
+    public:
+        ScopedRealtimeContext() noexcept {}
+    };
+   #endif
+}
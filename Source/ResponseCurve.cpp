@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+    ResponseCurve.cpp
+
+  ==============================================================================
+*/
+
+#include "ResponseCurve.h"
+
+void ResponseCurve::setGrid(int newNumPoints, double newSampleRate, float minFrequency, float maxFrequency)
+{
+    if (newNumPoints == numPoints && newSampleRate == sampleRate)
+        return;
+
+    numPoints = newNumPoints;
+    sampleRate = newSampleRate;
+
+    for (auto* values : { &phi, &phiSquared, &power, &numerator, &denominator })
+        values->resize((size_t) numPoints);
+
+    decibels.assign((size_t) numPoints, 0.0f);
+
+    for (int i = 0; i < numPoints; ++i)
+    {
+        auto frequency = minFrequency * std::pow((double) maxFrequency / minFrequency, (double) i / (double) numPoints);
+        auto halfSine = std::sin(juce::MathConstants<double>::pi * frequency / sampleRate);
+
+        phi[(size_t) i] = (float) (halfSine * halfSine);
+        phiSquared[(size_t) i] = phi[(size_t) i] * phi[(size_t) i];
+    }
+}
+
+void ResponseCurve::compute(const ChainCoefficients& chainCoefficients) noexcept
+{
+    if (numPoints == 0)
+        return;
+
+    juce::FloatVectorOperations::fill(power.data(), 1.0f, numPoints);
+
+    // Only the stages the audio thread actually runs
+    if (chainCoefficients.lowCutActive)
+        for (int i = 0; i <= (int) chainCoefficients.lowCutSlope; ++i)
+            multiplySection(chainCoefficients.lowCut[(size_t) i]);
+
+    if (chainCoefficients.peakActive)
+        multiplySection(chainCoefficients.peak);
+
+    if (chainCoefficients.highCutActive)
+        for (int i = 0; i <= (int) chainCoefficients.highCutSlope; ++i)
+            multiplySection(chainCoefficients.highCut[(size_t) i]);
+
+    // log10(0) is -inf, which the clamp turns into minDecibels
+    for (int i = 0; i < numPoints; ++i)
+        decibels[(size_t) i] = juce::jmax(minDecibels, 10.0f * std::log10(power[(size_t) i]));
+}
+
+void ResponseCurve::multiplySection(const BiquadCoefficients& section) noexcept
+{
+    // |B(e^jw)|^2 = (b0 + b1 + b2)^2 - 4 (b0 b1 + 4 b0 b2 + b1 b2) phi + 16 b0 b2 phi^2, likewise for A with a0 = 1
+    auto b0 = (double) section.b0, b1 = (double) section.b1, b2 = (double) section.b2;
+    auto a1 = (double) section.a1, a2 = (double) section.a2;
+
+    auto evaluate = [this](float* dest, double sum, double linear, double quadratic)
+    {
+        juce::FloatVectorOperations::fill(dest, (float) (sum * sum), numPoints);
+        juce::FloatVectorOperations::addWithMultiply(dest, phi.data(), (float) (-4.0 * linear), numPoints);
+        juce::FloatVectorOperations::addWithMultiply(dest, phiSquared.data(), (float) (16.0 * quadratic), numPoints);
+    };
+
+    evaluate(numerator.data(), b0 + b1 + b2, b0 * b1 + 4.0 * b0 * b2 + b1 * b2, b0 * b2);
+    evaluate(denominator.data(), 1.0 + a1 + a2, a1 + 4.0 * a2 + a1 * a2, a2);
+
+    // Plain loop, the compiler vectorises it; the clamp catches rounding just below zero at a notch
+    for (int i = 0; i < numPoints; ++i)
+        power[(size_t) i] *= juce::jmax(0.0f, numerator[(size_t) i]) / denominator[(size_t) i];
+}
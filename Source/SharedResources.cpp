@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    SharedResources.cpp
+
+  ==============================================================================
+*/
+
+#include "SharedResources.h"
+
+namespace SharedResources
+{
+    namespace
+    {
+        struct Entry
+        {
+            std::weak_ptr<const void> resource;
+            size_t numBytes{ 0 };
+        };
+
+        struct Registry
+        {
+            juce::CriticalSection lock;
+            std::map<juce::String, Entry> entries;
+
+            // Entries whose last user is gone
+            void removeExpired()
+            {
+                for (auto it = entries.begin(); it != entries.end();)
+                    it = it->second.resource.expired() ? entries.erase(it) : std::next(it);
+            }
+        };
+
+        // Constructed on first use, so instances created during static initialisation still find it
+        Registry& getRegistry()
+        {
+            static Registry registry;
+            return registry;
+        }
+    }
+
+    Usage getUsage()
+    {
+        auto& registry = getRegistry();
+        const juce::ScopedLock scopedLock(registry.lock);
+
+        registry.removeExpired();
+
+        Usage usage;
+        usage.numResources = (int) registry.entries.size();
+
+        for (const auto& [key, entry] : registry.entries)
+            usage.numBytes += entry.numBytes;
+
+        return usage;
+    }
+
+    namespace Detail
+    {
+        std::shared_ptr<const void> findOrCreate(const juce::String& key, const Creator& create)
+        {
+           #if SIMPLEPLUGIN_SHARED_RESOURCES
+            auto& registry = getRegistry();
+
+            // Held while creating, so instances preparing at the same time don't build the same resource twice
+            const juce::ScopedLock scopedLock(registry.lock);
+
+            registry.removeExpired();
+
+            auto found = registry.entries.find(key);
+
+            if (found != registry.entries.end())
+                if (auto resource = found->second.resource.lock())
+                    return resource;
+
+            auto [resource, numBytes] = create();
+
+            // Failures aren't cached, the next caller tries again
+            if (resource != nullptr)
+                registry.entries[key] = { resource, numBytes };
+
+            return resource;
+           #else
+            juce::ignoreUnused(key);
+            return create().first;
+           #endif
+        }
+    }
+}
@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    SharedResources.h
+
+    Process-wide registry of read-only data that every plugin instance
+    would otherwise build for itself: the factory program designs, the cut
+    filter tables, the analyzer's window table.
+    Entries are keyed by a string and only held weakly here, so the
+    last instance to drop one frees it.
+
+    Only immutable objects go in here. Anything an instance writes to, such
+    as filter, delay and reverb state, stays with the instance.
+
+    Build with SIMPLEPLUGIN_SHARED_RESOURCES=0 to give every instance its
+    own copies again, e.g. to compare the per-instance footprint.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#ifndef SIMPLEPLUGIN_SHARED_RESOURCES
+ #define SIMPLEPLUGIN_SHARED_RESOURCES 1
+#endif
+
+namespace SharedResources
+{
+    struct Usage
+    {
+        int numResources{ 0 };
+        size_t numBytes{ 0 };
+    };
+
+    // Resources still held by at least one instance
+    Usage getUsage();
+
+    namespace Detail
+    {
+        using Creator = std::function<std::pair<std::shared_ptr<const void>, size_t>()>;
+        std::shared_ptr<const void> findOrCreate(const juce::String& key, const Creator& create);
+    }
+
+    // Returns the resource stored under key, or creates it with create(), which returns a
+    // std::shared_ptr<Resource> and may return nullptr on failure. Resource provides
+    // getSizeInBytes(). Keys must be unique across resource types.
+    // Never call from the audio thread: it locks, and creating a resource allocates.
+    template <typename Resource, typename Factory>
+    std::shared_ptr<const Resource> get(const juce::String& key, Factory&& create)
+    {
+        return std::static_pointer_cast<const Resource>(Detail::findOrCreate(key, [&]
+        {
+            std::shared_ptr<const Resource> resource = create();
+            auto numBytes = resource != nullptr ? resource->getSizeInBytes() : (size_t) 0;
+
+            return std::make_pair(std::shared_ptr<const void>(resource), numBytes);
+        }));
+    }
+}
@@ -0,0 +1,73 @@
+/*
+  ==============================================================================
+
+    SilenceDetector.cpp
+
+  ==============================================================================
+*/
+
+#include "SilenceDetector.h"
+
+// decibelsToGain() treats anything at its default floor of -100 dB as silence
+const float SilenceDetector::threshold = juce::Decibels::decibelsToGain(thresholdDecibels, thresholdDecibels - 1.0f);
+
+void SilenceDetector::prepare(double newSampleRate) noexcept
+{
+    sampleRate = newSampleRate;
+    holdSamples = juce::roundToInt(holdSeconds * sampleRate);
+
+    reset();
+}
+
+void SilenceDetector::reset() noexcept
+{
+    silentSamples = 0;
+    idle = false;
+}
+
+void SilenceDetector::setMinimumSilence(float seconds) noexcept
+{
+    minimumSilentSamples = holdSamples + juce::roundToInt(seconds * sampleRate);
+}
+
+//==============================================================================
+SilenceDetector::Activity SilenceDetector::checkInput(const juce::dsp::AudioBlock<const float>& input) noexcept
+{
+    if (getPeak(input) >= threshold)
+    {
+        auto wasIdle = idle;
+
+        silentSamples = 0;
+        idle = false;
+
+        return wasIdle ? Activity::resuming : Activity::active;
+    }
+
+    if (idle)
+        return Activity::idle;
+
+    silentSamples = juce::jmin(silentSamples + (int) input.getNumSamples(), std::numeric_limits<int>::max() / 2);
+    return Activity::active;
+}
+
+void SilenceDetector::checkOutput(const juce::dsp::AudioBlock<const float>& output) noexcept
+{
+    // Only look at the output once the pre-delay can't be holding back a tail that hasn't started yet
+    if (silentSamples > minimumSilentSamples && getPeak(output) < threshold)
+        idle = true;
+}
+
+float SilenceDetector::getPeak(const juce::dsp::AudioBlock<const float>& block) noexcept
+{
+    auto peak = 0.0f;
+    auto numSamples = (int) block.getNumSamples();
+
+    for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
+    {
+        // Vectorised min/max; the absolute peak is the larger of the two magnitudes
+        auto range = juce::FloatVectorOperations::findMinAndMax(block.getChannelPointer(channel), numSamples);
+        peak = juce::jmax(peak, range.getEnd(), -range.getStart());
+    }
+
+    return peak;
+}
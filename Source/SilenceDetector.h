@@ -0,0 +1,64 @@
+/*
+  ==============================================================================
+
+    SilenceDetector.h
+
+    Decides when processBlock can stop working on a silent track. A block
+    counts as silent when its absolute peak is below the threshold. Once
+    the input has been silent for longer than the pre-delay plus a short
+    hold, and the processed output has decayed below the threshold too,
+    the detector goes idle: the processor clears the output instead of
+    running the chain, until a block with signal arrives.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+class SilenceDetector
+{
+public:
+    enum class Activity
+    {
+        active,
+        resuming,   // First block with signal after being idle; the chain holds stale state
+        idle
+    };
+
+    static constexpr float thresholdDecibels = -120.0f;
+    static constexpr double holdSeconds = 0.05;
+
+    SilenceDetector() = default;
+
+    void prepare(double sampleRate) noexcept;
+    void reset() noexcept;
+
+    // Silence in the input shorter than this never ends a tail; meant for the pre-delay
+    void setMinimumSilence(float seconds) noexcept;
+
+    // =======Audio thread=======
+    // Called with the input, before any processing
+    Activity checkInput(const juce::dsp::AudioBlock<const float>& input) noexcept;
+
+    // Called with the processed output; goes idle once the tail is below the threshold
+    void checkOutput(const juce::dsp::AudioBlock<const float>& output) noexcept;
+
+    bool isIdle() const noexcept { return idle; }
+
+    // Largest absolute sample over all channels of the block
+    static float getPeak(const juce::dsp::AudioBlock<const float>& block) noexcept;
+
+private:
+    static const float threshold;
+
+    double sampleRate{ 44100.0 };
+    int holdSamples{ 0 };
+    int minimumSilentSamples{ 0 };
+
+    int silentSamples{ 0 };
+    bool idle{ false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SilenceDetector)
+};
@@ -0,0 +1,217 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyzer.cpp
+
+  ==============================================================================
+*/
+
+#include "SpectrumAnalyzer.h"
+
+SpectrumAnalyzer::Window::Window()
+    : table((size_t) fftSize)
+{
+    juce::dsp::WindowingFunction<float>::fillWindowingTables(table.data(), (size_t) fftSize, juce::dsp::WindowingFunction<float>::hann);
+}
+
+size_t SpectrumAnalyzer::Window::getSizeInBytes() const noexcept
+{
+    return sizeof(*this) + table.size() * sizeof(float);
+}
+
+SpectrumAnalyzer::Storage::Storage()
+{
+    for (auto& tap : taps)
+    {
+        tap.fifoStorage.assign((size_t) fifoSize, 0.0f);
+        tap.history.assign((size_t) fftSize, 0.0f);
+        tap.smoothedDecibels.assign((size_t) maxColumns, minDecibels);
+    }
+
+    fftData.assign((size_t) (2 * fftSize), 0.0f);
+}
+
+//==============================================================================
+SpectrumAnalyzer::SpectrumAnalyzer()
+    : juce::Thread("Spectrum Analyzer"),
+      window(SharedResources::get<Window>("SpectrumAnalyzer/Window/" + juce::String(fftOrder),
+                                          [] { return std::make_shared<Window>(); }))
+{
+}
+
+SpectrumAnalyzer::~SpectrumAnalyzer()
+{
+    jassert(numViewers == 0);
+    stopThread(1000);
+}
+
+//==============================================================================
+void SpectrumAnalyzer::setEnabled(bool shouldBeEnabled) noexcept
+{
+    enabled.store(shouldBeEnabled);
+    updateActive();
+}
+
+void SpectrumAnalyzer::addViewer()
+{
+    if (++numViewers == 1)
+    {
+        storage = std::make_unique<Storage>();
+        liveStorage.store(storage.get());
+        startThread();
+    }
+
+    updateActive();
+}
+
+void SpectrumAnalyzer::removeViewer()
+{
+    jassert(numViewers > 0);
+
+    if (--numViewers == 0)
+    {
+        stopThread(1000);
+        liveStorage.store(nullptr);
+
+        // A push that picked up the buffers before they were withdrawn finishes within one block
+        while (pushesInProgress.load() > 0)
+            std::this_thread::yield();
+
+        storage.reset();
+    }
+
+    updateActive();
+}
+
+void SpectrumAnalyzer::updateActive() noexcept
+{
+    active.store(enabled.load() && isThreadRunning());
+}
+
+void SpectrumAnalyzer::setNumColumns(int numColumns) noexcept
+{
+    requestedColumns.store(juce::jlimit(0, maxColumns, numColumns), std::memory_order_relaxed);
+}
+
+//==============================================================================
+void SpectrumAnalyzer::pushSamples(Storage& storageToFill, Tap tap, const juce::dsp::AudioBlock<const float>& block) noexcept
+{
+    auto& buffers = storageToFill.taps[(size_t) tap];
+    auto numChannels = (int) block.getNumChannels();
+    auto numSamples = juce::jmin((int) block.getNumSamples(), buffers.fifo.getFreeSpace());
+
+    if (numChannels == 0 || numSamples == 0)
+        return;
+
+    int start1, size1, start2, size2;
+    buffers.fifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+
+    // Mono sum of all channels, straight into the FIFO
+    auto gain = 1.0f / (float) numChannels;
+
+    auto writeMonoSum = [&](int start, int size, int offset)
+    {
+        auto* destination = buffers.fifoStorage.data() + start;
+        juce::FloatVectorOperations::copyWithMultiply(destination, block.getChannelPointer(0) + offset, gain, size);
+
+        for (int channel = 1; channel < numChannels; ++channel)
+            juce::FloatVectorOperations::addWithMultiply(destination, block.getChannelPointer((size_t) channel) + offset, gain, size);
+    };
+
+    writeMonoSum(start1, size1, 0);
+
+    if (size2 > 0)
+        writeMonoSum(start2, size2, size1);
+
+    buffers.fifo.finishedWrite(size1 + size2);
+}
+
+//==============================================================================
+void SpectrumAnalyzer::run()
+{
+    while (! threadShouldExit())
+    {
+        wait(1000 / framesPerSecond);
+
+        for (int tap = 0; tap < numTaps; ++tap)
+            drain((Tap) tap);
+
+        auto numColumns = requestedColumns.load(std::memory_order_relaxed);
+
+        if (numColumns == 0)
+            continue;
+
+        auto& spectrum = storage->spectra.getWriteBuffer();
+        spectrum.numColumns = numColumns;
+
+        for (int tap = 0; tap < numTaps; ++tap)
+            analyse((Tap) tap, spectrum.levels[(size_t) tap], numColumns);
+
+        storage->spectra.publish();
+    }
+}
+
+void SpectrumAnalyzer::drain(Tap tap)
+{
+    auto& buffers = storage->taps[(size_t) tap];
+    auto& history = buffers.history;
+
+    auto numReady = buffers.fifo.getNumReady();
+
+    if (numReady == 0)
+        return;
+
+    // Only the newest fftSize samples matter
+    auto numToSkip = juce::jmax(0, numReady - fftSize);
+    auto numToRead = numReady - numToSkip;
+
+    if (numToSkip > 0)
+        buffers.fifo.finishedRead(numToSkip);
+
+    std::move(history.begin() + numToRead, history.end(), history.begin());
+
+    int start1, size1, start2, size2;
+    buffers.fifo.prepareToRead(numToRead, start1, size1, start2, size2);
+
+    auto* destination = history.data() + (fftSize - numToRead);
+    std::copy(buffers.fifoStorage.data() + start1, buffers.fifoStorage.data() + start1 + size1, destination);
+    std::copy(buffers.fifoStorage.data() + start2, buffers.fifoStorage.data() + start2 + size2, destination + size1);
+
+    buffers.fifo.finishedRead(size1 + size2);
+}
+
+void SpectrumAnalyzer::analyse(Tap tap, std::array<float, maxColumns>& columns, int numColumns)
+{
+    auto& buffers = storage->taps[(size_t) tap];
+    auto& fftData = storage->fftData;
+
+    juce::FloatVectorOperations::multiply(fftData.data(), buffers.history.data(), window->table.data(), fftSize);
+    storage->fft.performFrequencyOnlyForwardTransform(fftData.data());
+
+    // Full scale sine -> 0 dB: the Hann window halves the amplitude, the FFT scales it by fftSize / 2
+    auto normalisation = 4.0f / (float) fftSize;
+    auto binsPerHertz = (float) fftSize / (float) sampleRate.load();
+    auto lastBin = fftSize / 2;
+
+    for (int column = 0; column < numColumns; ++column)
+    {
+        auto lowFrequency = minFrequency * std::pow(maxFrequency / minFrequency, (float) column / (float) numColumns);
+        auto highFrequency = minFrequency * std::pow(maxFrequency / minFrequency, (float) (column + 1) / (float) numColumns);
+
+        // Several bins per column at the top, at least one at the bottom
+        auto firstBin = juce::jlimit(0, lastBin, (int) (lowFrequency * binsPerHertz));
+        auto endBin = juce::jlimit(firstBin + 1, lastBin + 1, (int) (highFrequency * binsPerHertz) + 1);
+
+        auto magnitude = 0.0f;
+
+        for (int bin = firstBin; bin < endBin; ++bin)
+            magnitude = juce::jmax(magnitude, fftData[(size_t) bin]);
+
+        auto decibels = juce::Decibels::gainToDecibels(magnitude * normalisation, minDecibels);
+
+        // Instant attack, slow release, so short peaks stay visible between frames
+        auto& smoothed = buffers.smoothedDecibels[(size_t) column];
+        smoothed = juce::jmax(decibels, smoothed - releaseDecibelsPerFrame);
+        columns[(size_t) column] = smoothed;
+    }
+}
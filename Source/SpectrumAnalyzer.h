@@ -0,0 +1,154 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyzer.h
+
+    Pre- and post-EQ spectrum of the processed signal. The audio thread
+    pushes a mono sum of each tap into a wait-free FIFO; a background thread
+    drains the FIFOs at a capped frame rate, runs the windowed FFTs and
+    reduces the spectra to one level per display column. The finished
+    columns are handed to the editor through a TripleBuffer.
+
+    The audio thread only pushes while the analyzer is enabled and an
+    editor is watching; otherwise its cost is one relaxed atomic load.
+    The FIFOs and analysis buffers only exist while a viewer is attached,
+    so an instance that never opens its editor doesn't carry them.
+
+    The window table is the same for every instance and lives in
+    SharedResources. Each analyzer keeps its own FFT: the engines behind it
+    lock or use member work buffers, so one plan can't serve several
+    analysis threads without them contending.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SharedResources.h"
+#include "TripleBuffer.h"
+
+class SpectrumAnalyzer  : private juce::Thread
+{
+public:
+    enum Tap
+    {
+        preEq,
+        postEq,
+        numTaps
+    };
+
+    static constexpr int fftOrder = 11;
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int maxColumns = 2048;
+
+    static constexpr float minFrequency = 20.0f;
+    static constexpr float maxFrequency = 20000.0f;
+    static constexpr float minDecibels = -96.0f;
+
+    // Levels in dB per display column, from minFrequency to maxFrequency on a log scale
+    struct Spectrum
+    {
+        int numColumns{ 0 };
+        std::array<std::array<float, maxColumns>, numTaps> levels;
+    };
+
+    SpectrumAnalyzer();
+    ~SpectrumAnalyzer() override;
+
+    // Only stores the rate: the FIFOs belong to the viewers, not to the processing setup
+    void prepare(double newSampleRate) noexcept { sampleRate.store(newSampleRate); }
+
+    // =======Any thread=======
+    void setEnabled(bool shouldBeEnabled) noexcept;
+    bool isEnabled() const noexcept { return enabled.load(std::memory_order_relaxed); }
+
+    // =======Audio thread=======
+    // Wait-free; drops samples while the FIFO is full
+    void push(Tap tap, const juce::dsp::AudioBlock<const float>& block) noexcept
+    {
+        if (! active.load(std::memory_order_relaxed))
+            return;
+
+        // Counted, so the last viewer can't free the buffers under an unfinished push
+        pushesInProgress.fetch_add(1);
+
+        if (auto* buffers = liveStorage.load())
+            pushSamples(*buffers, tap, block);
+
+        pushesInProgress.fetch_sub(1);
+    }
+
+    // =======Message thread=======
+    // The first viewer allocates the buffers and starts the analysis thread; the last one stops it
+    // and frees them again
+    void addViewer();
+    void removeViewer();
+
+    void setNumColumns(int numColumns) noexcept;
+
+    // Single reader, only while a viewer is attached: returns true if a newer spectrum was published since the last call
+    bool pullSpectrum() noexcept { return storage != nullptr && storage->spectra.pull(); }
+    const Spectrum& getSpectrum() const noexcept { return storage->spectra.getReadBuffer(); }
+
+private:
+    void run() override;
+    void updateActive() noexcept;
+
+    struct Storage;
+    static void pushSamples(Storage& storageToFill, Tap tap, const juce::dsp::AudioBlock<const float>& block) noexcept;
+
+    // Moves everything the FIFO holds into the tap's history of the last fftSize samples
+    void drain(Tap tap);
+    void analyse(Tap tap, std::array<float, maxColumns>& columns, int numColumns);
+
+    static constexpr int framesPerSecond = 30;
+    static constexpr int fifoSize = 1 << 15;
+    static constexpr float releaseDecibelsPerFrame = 3.0f;
+
+    struct TapBuffers
+    {
+        juce::AbstractFifo fifo{ fifoSize };
+        std::vector<float> fifoStorage;
+
+        // Analysis thread only
+        std::vector<float> history;
+        std::vector<float> smoothedDecibels;
+    };
+
+    // Hann window, read-only once built
+    struct Window
+    {
+        Window();
+        size_t getSizeInBytes() const noexcept;
+
+        std::vector<float> table;
+    };
+
+    std::shared_ptr<const Window> window;
+
+    // Everything that is only needed while the spectrum is shown
+    struct Storage
+    {
+        Storage();
+
+        std::array<TapBuffers, numTaps> taps;
+        juce::dsp::FFT fft{ fftOrder };
+        std::vector<float> fftData;
+        TripleBuffer<Spectrum> spectra;
+    };
+
+    // Owned on the message thread; the audio thread reaches it through liveStorage
+    std::unique_ptr<Storage> storage;
+    std::atomic<Storage*> liveStorage{ nullptr };
+    std::atomic<int> pushesInProgress{ 0 };
+
+    std::atomic<double> sampleRate{ 44100.0 };
+    std::atomic<int> requestedColumns{ 0 };
+
+    std::atomic<bool> enabled{ true };
+    std::atomic<bool> active{ false };
+    int numViewers{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrumAnalyzer)
+};
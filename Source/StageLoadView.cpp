@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    StageLoadView.cpp
+
+  ==============================================================================
+*/
+
+#include "StageLoadView.h"
+
+StageLoadView::StageLoadView(StageProfiler& profilerToShow, const CoefficientDesigner& designerToShow)
+    : profiler(profilerToShow),
+      designer(designerToShow)
+{
+    profiler.getSnapshot(previous);
+    startTimerHz(4);
+}
+
+StageLoadView::~StageLoadView()
+{
+    stopTimer();
+}
+
+void StageLoadView::timerCallback()
+{
+    auto newRedesignsPerSecond = designer.getRedesignsPerSecond();
+
+    if (newRedesignsPerSecond != redesignsPerSecond)
+    {
+        redesignsPerSecond = newRedesignsPerSecond;
+        repaint();
+    }
+
+    if (! StageProfiler::isEnabled)
+        return;
+
+    profiler.getSnapshot(current);
+
+    // Nothing was processed since the last refresh, keep showing the last loads
+    if (current.numBlocks == previous.numBlocks)
+        return;
+
+    for (int stage = 0; stage < StageProfiler::numStages; ++stage)
+        loads[(size_t) stage] = StageProfiler::getLoad(current, previous, stage);
+
+    previous = current;
+    repaint();
+}
+
+void StageLoadView::paint(juce::Graphics& g)
+{
+    g.fillAll(getLookAndFeel().findColour(juce::ResizableWindow::backgroundColourId).darker(0.2f));
+    g.setFont(12.0f);
+
+    auto bounds = getLocalBounds().reduced(4, 0);
+    auto titleRow = bounds.removeFromTop(rowHeight);
+
+    g.setColour(juce::Colours::white);
+    g.drawText(juce::String(redesignsPerSecond) + " redesigns/s", titleRow.removeFromRight(100), juce::Justification::centredRight);
+
+    if (! StageProfiler::isEnabled)
+    {
+        g.setColour(juce::Colours::grey);
+        g.drawText("Profiling is compiled out (SIMPLEPLUGIN_PROFILING=0)", titleRow, juce::Justification::centredLeft);
+        return;
+    }
+
+    g.drawText("Stage load in % of the block budget (average / p99)", titleRow, juce::Justification::centredLeft);
+
+    for (int stage = 0; stage < StageProfiler::numStages; ++stage)
+    {
+        auto row = bounds.removeFromTop(rowHeight);
+        const auto& load = loads[(size_t) stage];
+
+        g.setColour(juce::Colours::white);
+        g.drawText(StageProfiler::getStageName(stage), row.removeFromLeft(150), juce::Justification::centredLeft);
+        g.drawText(juce::String(load.average, 2) + " / " + juce::String((int) load.percentile99), row.removeFromRight(80),
+                   juce::Justification::centredRight);
+
+        // Bar scaled to the full budget, with a tick at the 99th percentile
+        auto bar = row.reduced(2, 4).toFloat();
+        g.setColour(juce::Colours::black.withAlpha(0.3f));
+        g.fillRect(bar);
+
+        g.setColour(load.percentile99 >= 100.0f ? juce::Colours::red : juce::Colours::orange);
+        g.fillRect(bar.withWidth(bar.getWidth() * juce::jmin(1.0f, load.average / 100.0f)));
+        g.fillRect(bar.getX() + bar.getWidth() * juce::jmin(1.0f, load.percentile99 / 100.0f) - 1.0f, bar.getY(), 2.0f, bar.getHeight());
+    }
+}
@@ -0,0 +1,43 @@
+/*
+  ==============================================================================
+
+    StageLoadView.h
+
+    Load of every processBlock stage, in percent of the real-time budget,
+    averaged over the last refresh interval, and the number of stage
+    redesigns the coefficient designer ran during the last second.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "CoefficientDesigner.h"
+#include "StageProfiler.h"
+
+class StageLoadView  : public juce::Component,
+                       private juce::Timer
+{
+public:
+    StageLoadView(StageProfiler& profilerToShow, const CoefficientDesigner& designerToShow);
+    ~StageLoadView() override;
+
+    void paint(juce::Graphics& g) override;
+
+    static constexpr int rowHeight = 18;
+    static int getPreferredHeight() { return rowHeight * (StageProfiler::numStages + 1); }
+
+private:
+    void timerCallback() override;
+
+    StageProfiler& profiler;
+    const CoefficientDesigner& designer;
+
+    int redesignsPerSecond{ 0 };
+
+    StageProfiler::Snapshot previous, current;
+    std::array<StageProfiler::Load, StageProfiler::numStages> loads;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StageLoadView)
+};
@@ -0,0 +1,198 @@
+/*
+  ==============================================================================
+
+    StageProfiler.cpp
+
+  ==============================================================================
+*/
+
+#include "StageProfiler.h"
+
+namespace
+{
+    template <typename Value>
+    void increment(std::atomic<Value>& counter, Value amount) noexcept
+    {
+        // Single writer, so a read-modify-write without a locked instruction is enough
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+}
+
+StageProfiler::StageProfiler()
+{
+    for (auto& histogram : histograms)
+        for (auto& bucket : histogram)
+            bucket.store(0);
+
+    for (auto& stageTicks : ticks)
+        stageTicks.store(0);
+}
+
+const char* StageProfiler::getStageName(int stage)
+{
+    switch (stage)
+    {
+        case parameterFetch:    return "Parameter fetch";
+        case coefficientUpdate: return "Coefficient update";
+        case equaliser:         return "Low cut/peak/high cut";
+        case preDelay:          return "Pre-delay";
+        case reverb:            return "Reverb";
+        case mix:               return "Dry/wet mix";
+        case wholeBlock:        return "processBlock";
+        default:                return "";
+    }
+}
+
+void StageProfiler::prepare(double sampleRate)
+{
+    ticksPerSample = (double) juce::Time::getHighResolutionTicksPerSecond() / sampleRate;
+}
+
+//==============================================================================
+void StageProfiler::beginBlock(int numSamples) noexcept
+{
+    blockBudgetTicks = juce::jmax((juce::int64) 1, (juce::int64) (numSamples * ticksPerSample));
+
+    increment(budgetTicks, (juce::uint64) blockBudgetTicks);
+    increment(numBlocks, (juce::uint32) 1);
+}
+
+void StageProfiler::addStage(Stage stage, juce::int64 start, juce::int64 end) noexcept
+{
+    auto duration = end - start;
+    auto bucket = (int) juce::jmin((juce::int64) numBuckets - 1, duration * 100 / blockBudgetTicks);
+
+    increment(ticks[(size_t) stage], (juce::uint64) duration);
+    increment(histograms[(size_t) stage][(size_t) bucket], (juce::uint32) 1);
+
+    if (tracing.load(std::memory_order_acquire))
+    {
+        auto index = numTraceEvents.load(std::memory_order_relaxed);
+
+        // A full trace simply stops growing
+        if (index < maxTraceEvents)
+        {
+            traceEvents[(size_t) index] = { start, end, stage };
+            numTraceEvents.store(index + 1, std::memory_order_release);
+        }
+    }
+}
+
+//==============================================================================
+void StageProfiler::getSnapshot(Snapshot& snapshot) const noexcept
+{
+    for (size_t stage = 0; stage < (size_t) numStages; ++stage)
+    {
+        for (size_t bucket = 0; bucket < (size_t) numBuckets; ++bucket)
+            snapshot.histograms[stage][bucket] = histograms[stage][bucket].load(std::memory_order_relaxed);
+
+        snapshot.ticks[stage] = ticks[stage].load(std::memory_order_relaxed);
+    }
+
+    snapshot.budgetTicks = budgetTicks.load(std::memory_order_relaxed);
+    snapshot.numBlocks = numBlocks.load(std::memory_order_relaxed);
+}
+
+StageProfiler::Load StageProfiler::getLoad(const Snapshot& now, const Snapshot& before, int stage) noexcept
+{
+    Load load;
+
+    auto budget = now.budgetTicks - before.budgetTicks;
+
+    if (budget == 0)
+        return load;
+
+    load.average = (float) (100.0 * (double) (now.ticks[(size_t) stage] - before.ticks[(size_t) stage]) / (double) budget);
+
+    const auto& histogramNow = now.histograms[(size_t) stage];
+    const auto& histogramBefore = before.histograms[(size_t) stage];
+
+    juce::uint32 total = 0;
+
+    for (size_t bucket = 0; bucket < (size_t) numBuckets; ++bucket)
+        total += histogramNow[bucket] - histogramBefore[bucket];
+
+    juce::uint32 count = 0;
+    auto reached99 = false;
+
+    for (size_t bucket = 0; bucket < (size_t) numBuckets; ++bucket)
+    {
+        auto hits = histogramNow[bucket] - histogramBefore[bucket];
+
+        if (hits == 0)
+            continue;
+
+        count += hits;
+        load.peak = (float) bucket;
+
+        if (! reached99 && (juce::uint64) count * 100 >= (juce::uint64) total * 99)
+        {
+            load.percentile99 = (float) bucket;
+            reached99 = true;
+        }
+    }
+
+    return load;
+}
+
+juce::String StageProfiler::createReport(const Snapshot& now, const Snapshot& before)
+{
+    juce::String report;
+    report << "Stage loads over " << (int) (now.numBlocks - before.numBlocks) << " blocks, in % of the real-time budget:\n";
+
+    for (int stage = 0; stage < numStages; ++stage)
+    {
+        auto load = getLoad(now, before, stage);
+
+        report << juce::String(getStageName(stage)).paddedRight(' ', 24)
+               << " average " << juce::String(load.average, 2).paddedLeft(' ', 6)
+               << "  p99 " << juce::String((int) load.percentile99).paddedLeft(' ', 3)
+               << "  peak " << juce::String((int) load.peak).paddedLeft(' ', 3) << "\n";
+    }
+
+    return report;
+}
+
+//==============================================================================
+void StageProfiler::startTrace()
+{
+    if (tracing.load())
+        return;
+
+    // Never reallocated afterwards, so the audio thread can't see the storage move
+    if (traceEvents.empty())
+        traceEvents.resize((size_t) maxTraceEvents);
+
+    numTraceEvents.store(0);
+    traceStart = juce::Time::getHighResolutionTicks();
+    tracing.store(true, std::memory_order_release);
+}
+
+void StageProfiler::stopTrace() noexcept
+{
+    tracing.store(false, std::memory_order_release);
+}
+
+bool StageProfiler::writeChromeTrace(const juce::File& file) const
+{
+    auto numEvents = numTraceEvents.load(std::memory_order_acquire);
+    auto microsecondsPerTick = 1.0e6 / (double) juce::Time::getHighResolutionTicksPerSecond();
+
+    juce::MemoryOutputStream json;
+    json << "{\"traceEvents\":[\n";
+
+    for (int i = 0; i < numEvents; ++i)
+    {
+        const auto& event = traceEvents[(size_t) i];
+
+        // Complete events ("X") on one track; the block events enclose their stages
+        json << (i > 0 ? ",\n" : "")
+             << "{\"name\":\"" << getStageName(event.stage) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1"
+             << ",\"ts\":" << juce::String((double) (event.start - traceStart) * microsecondsPerTick, 3)
+             << ",\"dur\":" << juce::String((double) (event.end - event.start) * microsecondsPerTick, 3) << "}";
+    }
+
+    json << "\n],\"displayTimeUnit\":\"ns\"}\n";
+
+    return file.replaceWithData(json.getData(), json.getDataSize());
+}
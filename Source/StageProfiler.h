@@ -0,0 +1,166 @@
+/*
+  ==============================================================================
+
+    StageProfiler.h
+
+    Per-stage timing of processBlock. The audio thread takes a timestamp
+    pair around each stage and adds the duration to lock-free counters and
+    a histogram of load, in percent of the block's real-time budget. Other
+    threads read snapshots and diff them to get the load over any window.
+
+    On request the stages are also recorded as events and written out as a
+    Chrome trace (chrome://tracing, Perfetto).
+
+    Build with SIMPLEPLUGIN_PROFILING=0 to compile the timing out of the
+    audio thread entirely.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#ifndef SIMPLEPLUGIN_PROFILING
+ #define SIMPLEPLUGIN_PROFILING 1
+#endif
+
+class StageProfiler
+{
+public:
+    // Low cut, peak and high cut run fused in one pass, so they are timed together as the equaliser
+    enum Stage
+    {
+        parameterFetch,
+        coefficientUpdate,
+        equaliser,
+        preDelay,
+        reverb,
+        mix,
+        wholeBlock,
+        numStages
+    };
+
+    // Loads of 0..99 % in 1 % steps, plus one bucket for overloads
+    static constexpr int numBuckets = 101;
+    static constexpr bool isEnabled = SIMPLEPLUGIN_PROFILING != 0;
+
+    StageProfiler();
+
+    static const char* getStageName(int stage);
+
+    void prepare(double sampleRate);
+
+    // =======Audio thread=======
+    class ScopedStage
+    {
+    public:
+       #if SIMPLEPLUGIN_PROFILING
+        ScopedStage(StageProfiler& profilerToUse, Stage stageToTime) noexcept
+            : profiler(profilerToUse), stage(stageToTime), start(juce::Time::getHighResolutionTicks())
+        {
+        }
+
+        ~ScopedStage() noexcept
+        {
+            profiler.addStage(stage, start, juce::Time::getHighResolutionTicks());
+        }
+
+       private:
+        StageProfiler& profiler;
+        const Stage stage;
+        const juce::int64 start;
+       #else
+        ScopedStage(StageProfiler&, Stage) noexcept {}
+       #endif
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedStage)
+    };
+
+    // Sets the real-time budget for the stages of one block and times the block as a whole
+    class ScopedBlock
+    {
+    public:
+       #if SIMPLEPLUGIN_PROFILING
+        ScopedBlock(StageProfiler& profilerToUse, int numSamples) noexcept
+            : profiler(profilerToUse), start(juce::Time::getHighResolutionTicks())
+        {
+            profiler.beginBlock(numSamples);
+        }
+
+        ~ScopedBlock() noexcept
+        {
+            profiler.addStage(wholeBlock, start, juce::Time::getHighResolutionTicks());
+        }
+
+       private:
+        StageProfiler& profiler;
+        const juce::int64 start;
+       #else
+        ScopedBlock(StageProfiler&, int) noexcept {}
+       #endif
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedBlock)
+    };
+
+    // =======Any thread=======
+    struct Snapshot
+    {
+        std::array<std::array<juce::uint32, numBuckets>, numStages> histograms{};
+        std::array<juce::uint64, numStages> ticks{};
+        juce::uint64 budgetTicks{ 0 };
+        juce::uint32 numBlocks{ 0 };
+    };
+
+    struct Load
+    {
+        float average{ 0.f };   // Stage time over budget, in percent
+        float peak{ 0.f };      // Highest histogram bucket that was hit
+        float percentile99{ 0.f };
+    };
+
+    void getSnapshot(Snapshot& snapshot) const noexcept;
+
+    // Load of one stage between two snapshots
+    static Load getLoad(const Snapshot& now, const Snapshot& before, int stage) noexcept;
+
+    // One line per stage, for the log
+    static juce::String createReport(const Snapshot& now, const Snapshot& before);
+
+    // =======Message thread=======
+    // Records every stage as a trace event until stopTrace(); the event storage is allocated once, here
+    void startTrace();
+    void stopTrace() noexcept;
+    bool isTracing() const noexcept { return tracing.load(std::memory_order_relaxed); }
+
+    // Writes the events recorded by the last trace in Chrome's trace event format
+    bool writeChromeTrace(const juce::File& file) const;
+
+private:
+    void beginBlock(int numSamples) noexcept;
+    void addStage(Stage stage, juce::int64 start, juce::int64 end) noexcept;
+
+    struct TraceEvent
+    {
+        juce::int64 start, end;
+        Stage stage;
+    };
+
+    static constexpr int maxTraceEvents = 1 << 16;
+
+    double ticksPerSample{ 0.0 };
+    juce::int64 blockBudgetTicks{ 1 };
+
+    // Written by the audio thread only, so updates are plain relaxed load + store
+    std::array<std::array<std::atomic<juce::uint32>, numBuckets>, numStages> histograms;
+    std::array<std::atomic<juce::uint64>, numStages> ticks;
+    std::atomic<juce::uint64> budgetTicks{ 0 };
+    std::atomic<juce::uint32> numBlocks{ 0 };
+
+    std::vector<TraceEvent> traceEvents;
+    std::atomic<int> numTraceEvents{ 0 };
+    std::atomic<bool> tracing{ false };
+    juce::int64 traceStart{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StageProfiler)
+};
@@ -0,0 +1,311 @@
+/*
+  ==============================================================================
+
+    SvfFilterChain.cpp
+
+  ==============================================================================
+*/
+
+#include "SvfFilterChain.h"
+
+void SvfFilterChain::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    sampleRate = spec.sampleRate;
+    maxFrequency = (float) (sampleRate * 0.49);
+
+    channelStates.resize((size_t) spec.numChannels);
+
+    for (auto* value : { &lowCutFrequency, &highCutFrequency, &peakFrequency, &peakQuality })
+        value->reset(sampleRate, smoothingSeconds);
+
+    peakGainInDecibels.reset(sampleRate, smoothingSeconds);
+
+    for (auto& amount : amounts)
+        amount.reset(sampleRate, smoothingSeconds);
+
+    setDampings(lowCutDampings, numLowCut);
+    setDampings(highCutDampings, numHighCut);
+
+    hasTargets = false;
+
+    reset();
+}
+
+void SvfFilterChain::reset() noexcept
+{
+    std::fill(channelStates.begin(), channelStates.end(), ChannelState{});
+
+    for (auto* value : { &lowCutFrequency, &highCutFrequency, &peakFrequency, &peakQuality })
+        value->setCurrentAndTargetValue(value->getTargetValue());
+
+    peakGainInDecibels.setCurrentAndTargetValue(peakGainInDecibels.getTargetValue());
+
+    for (auto& amount : amounts)
+        amount.setCurrentAndTargetValue(amount.getTargetValue());
+
+    updateFixedSections();
+}
+
+//==============================================================================
+void SvfFilterChain::setTarget(juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative>& value, float target, bool jump) noexcept
+{
+    if (jump)
+        value.setCurrentAndTargetValue(target);
+    else
+        value.setTargetValue(target);
+}
+
+void SvfFilterChain::setTarget(juce::SmoothedValue<float>& value, float target, bool jump) noexcept
+{
+    if (jump)
+        value.setCurrentAndTargetValue(target);
+    else
+        value.setTargetValue(target);
+}
+
+void SvfFilterChain::setDampings(std::array<float, maxSections>& dampings, int numSections) noexcept
+{
+    // Poles of an order 2n Butterworth, paired into sections: Q = 1 / (2 cos((2i + 1) pi / 4n))
+    auto order = 2 * numSections;
+
+    for (int i = 0; i < numSections; ++i)
+        dampings[(size_t) i] = (float) (2.0 * std::cos((2 * i + 1) * juce::MathConstants<double>::pi / (2 * order)));
+}
+
+bool SvfFilterChain::isIdle(Stage stage) const noexcept
+{
+    const auto& amount = amounts[(size_t) stage];
+    return ! amount.isSmoothing() && amount.getTargetValue() == 0.0f;
+}
+
+void SvfFilterChain::setTargets(const ChainCoefficients& chainCoefficients) noexcept
+{
+    auto isFirst = ! hasTargets;
+    hasTargets = true;
+
+    const std::array<bool, numStages> active{ chainCoefficients.lowCutActive, chainCoefficients.peakActive, chainCoefficients.highCutActive };
+
+    // A stage that is faded out can't be heard, so its settings jump rather than glide;
+    // one that fades back in starts from silence at its new settings
+    std::array<bool, numStages> jumps{};
+
+    for (size_t stage = 0; stage < numStages; ++stage)
+    {
+        jumps[stage] = isFirst || isIdle((Stage) stage);
+
+        if (active[stage] && jumps[stage])
+        {
+            for (auto& state : channelStates)
+            {
+                if (stage == lowCutStage)
+                    state.lowCut = {};
+                else if (stage == peakStage)
+                    state.peak = {};
+                else
+                    state.highCut = {};
+            }
+        }
+
+        setTarget(amounts[stage], active[stage] ? 1.0f : 0.0f, isFirst);
+    }
+
+    setTarget(lowCutFrequency, juce::jlimit(1.0f, maxFrequency, chainCoefficients.lowCutFrequency), jumps[lowCutStage]);
+    setTarget(highCutFrequency, juce::jlimit(1.0f, maxFrequency, chainCoefficients.highCutFrequency), jumps[highCutStage]);
+    setTarget(peakFrequency, juce::jlimit(1.0f, maxFrequency, chainCoefficients.peakFrequency), jumps[peakStage]);
+    setTarget(peakGainInDecibels, chainCoefficients.peakGainInDecibels, jumps[peakStage]);
+    setTarget(peakQuality, juce::jmax(0.01f, chainCoefficients.peakQuality), jumps[peakStage]);
+
+    // Sections that join a cut start from silence; a slope change takes effect at once, as in the biquad chain
+    auto setSlope = [this](Slope slope, int& numSections, std::array<float, maxSections>& dampings,
+                           std::array<State, maxSections> ChannelState::* states)
+    {
+        auto newNumSections = (int) slope + 1;
+
+        for (auto& state : channelStates)
+            for (int i = numSections; i < newNumSections; ++i)
+                (state.*states)[(size_t) i] = {};
+
+        numSections = newNumSections;
+        setDampings(dampings, numSections);
+    };
+
+    setSlope(chainCoefficients.lowCutSlope, numLowCut, lowCutDampings, &ChannelState::lowCut);
+    setSlope(chainCoefficients.highCutSlope, numHighCut, highCutDampings, &ChannelState::highCut);
+
+    updateFixedSections();
+}
+
+//==============================================================================
+SvfFilterChain::Section SvfFilterChain::makeSection(float g, float k) noexcept
+{
+    Section section;
+    section.a1 = 1.0f / (1.0f + g * (g + k));
+    section.a2 = g * section.a1;
+    section.a3 = g * section.a2;
+    section.k = k;
+
+    return section;
+}
+
+float SvfFilterChain::prewarp(float frequency) const noexcept
+{
+    return std::tan(juce::MathConstants<float>::pi * juce::jmin(frequency, maxFrequency) / (float) sampleRate);
+}
+
+void SvfFilterChain::updateCut(CutSections& sections, const std::array<float, maxSections>& dampings, int numSections, float frequency) const noexcept
+{
+    auto g = prewarp(frequency);
+
+    for (int i = 0; i < numSections; ++i)
+        sections[(size_t) i] = makeSection(g, dampings[(size_t) i]);
+}
+
+SvfFilterChain::Section SvfFilterChain::makePeak(float frequency, float gainInDecibels, float quality) const noexcept
+{
+    // Same bell as makePeakFilter: the damping narrows by sqrt(gain), the band is added back with gain - 1
+    auto amplitude = std::pow(10.0f, gainInDecibels / 40.0f);
+    auto section = makeSection(prewarp(frequency), 1.0f / (quality * amplitude));
+    section.m = section.k * (amplitude * amplitude - 1.0f);
+
+    return section;
+}
+
+void SvfFilterChain::updateFixedSections() noexcept
+{
+    updateCut(lowCut, lowCutDampings, numLowCut, lowCutFrequency.getCurrentValue());
+    updateCut(highCut, highCutDampings, numHighCut, highCutFrequency.getCurrentValue());
+    peak = makePeak(peakFrequency.getCurrentValue(), peakGainInDecibels.getCurrentValue(), peakQuality.getCurrentValue());
+}
+
+//==============================================================================
+template <SvfFilterChain::Response response>
+void SvfFilterChain::processStage(float* samples, int numSamples, const Section* sections, int sectionStride,
+                                  int numSections, State* states, const float* amountValues) noexcept
+{
+    // State in locals so the stores to the block can't force it to be reloaded
+    std::array<State, maxSections> localStates;
+    std::copy(states, states + numSections, localStates.begin());
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const auto* sampleSections = sections + i * sectionStride;
+        auto input = samples[i];
+        auto output = input;
+
+        for (int section = 0; section < numSections; ++section)
+            output = tick<response>(output, sampleSections[section], localStates[(size_t) section]);
+
+        samples[i] = amountValues == nullptr ? output : input + amountValues[i] * (output - input);
+    }
+
+    std::copy(localStates.begin(), localStates.begin() + numSections, states);
+}
+
+void SvfFilterChain::process(const juce::dsp::ProcessContextReplacing<float>& context) noexcept
+{
+    if (isIdle(lowCutStage) && isIdle(peakStage) && isIdle(highCutStage))
+        return;
+
+    const auto& block = context.getOutputBlock();
+    auto numSamples = (int) block.getNumSamples();
+
+    for (int start = 0; start < numSamples; start += chunkSize)
+        processChunk(block, start, juce::jmin(chunkSize, numSamples - start));
+}
+
+void SvfFilterChain::processChunk(const juce::dsp::AudioBlock<float>& block, int start, int numSamples) noexcept
+{
+    auto numChannels = juce::jmin(block.getNumChannels(), channelStates.size());
+
+    // Wet amount per sample while a stage fades, null once it is fully in
+    auto getAmounts = [&](Stage stage) -> const float*
+    {
+        auto& amount = amounts[(size_t) stage];
+
+        if (! amount.isSmoothing())
+            return nullptr;
+
+        auto& values = amountChunks[(size_t) stage];
+
+        for (int i = 0; i < numSamples; ++i)
+            values[(size_t) i] = amount.getNextValue();
+
+        return values.data();
+    };
+
+    // A faded out stage isn't run, and whatever it was gliding to applies at once
+    auto runCut = [&](Stage stage, juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative>& frequency,
+                      CutSections& fixedSections, std::array<CutSections, chunkSize>& chunkSections,
+                      const std::array<float, maxSections>& dampings, int numSections,
+                      std::array<State, maxSections> ChannelState::* states, auto runStage)
+    {
+        if (isIdle(stage))
+        {
+            if (frequency.isSmoothing())
+            {
+                frequency.setCurrentAndTargetValue(frequency.getTargetValue());
+                updateCut(fixedSections, dampings, numSections, frequency.getCurrentValue());
+            }
+
+            return;
+        }
+
+        const auto* amountValues = getAmounts(stage);
+        const Section* sections = fixedSections.data();
+        auto stride = 0;
+
+        if (frequency.isSmoothing())
+        {
+            for (int i = 0; i < numSamples; ++i)
+                updateCut(chunkSections[(size_t) i], dampings, numSections, frequency.getNextValue());
+
+            sections = chunkSections.front().data();
+            stride = maxSections;
+
+            if (! frequency.isSmoothing())
+                updateCut(fixedSections, dampings, numSections, frequency.getCurrentValue());
+        }
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+            runStage(block.getChannelPointer(channel) + start, numSamples, sections, stride, numSections,
+                     (channelStates[channel].*states).data(), amountValues);
+    };
+
+    runCut(lowCutStage, lowCutFrequency, lowCut, lowCutChunk, lowCutDampings, numLowCut, &ChannelState::lowCut,
+           &processStage<Response::highpass>);
+
+    if (isIdle(peakStage))
+    {
+        if (peakFrequency.isSmoothing() || peakGainInDecibels.isSmoothing() || peakQuality.isSmoothing())
+        {
+            peakFrequency.setCurrentAndTargetValue(peakFrequency.getTargetValue());
+            peakGainInDecibels.setCurrentAndTargetValue(peakGainInDecibels.getTargetValue());
+            peakQuality.setCurrentAndTargetValue(peakQuality.getTargetValue());
+            peak = makePeak(peakFrequency.getCurrentValue(), peakGainInDecibels.getCurrentValue(), peakQuality.getCurrentValue());
+        }
+    }
+    else
+    {
+        const auto* amountValues = getAmounts(peakStage);
+        const Section* sections = &peak;
+        auto stride = 0;
+
+        if (peakFrequency.isSmoothing() || peakGainInDecibels.isSmoothing() || peakQuality.isSmoothing())
+        {
+            for (int i = 0; i < numSamples; ++i)
+                peakChunk[(size_t) i] = makePeak(peakFrequency.getNextValue(), peakGainInDecibels.getNextValue(), peakQuality.getNextValue());
+
+            sections = peakChunk.data();
+            stride = 1;
+
+            peak = makePeak(peakFrequency.getCurrentValue(), peakGainInDecibels.getCurrentValue(), peakQuality.getCurrentValue());
+        }
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+            processStage<Response::bell>(block.getChannelPointer(channel) + start, numSamples, sections, stride, 1,
+                                         &channelStates[channel].peak, amountValues);
+    }
+
+    runCut(highCutStage, highCutFrequency, highCut, highCutChunk, highCutDampings, numHighCut, &ChannelState::highCut,
+           &processStage<Response::lowpass>);
+}
@@ -0,0 +1,160 @@
+/*
+  ==============================================================================
+
+    SvfFilterChain.h
+
+    The same low cut, peak and high cut as MultichannelFilterChain, built
+    from topology-preserving trapezoidal state-variable filters (in Andrew
+    Simper's form). A section is set by a single tan of its cut-off and
+    stays well behaved while it moves, so the cut-offs, the peak gain and
+    the peak quality glide to every new setting sample by sample instead of
+    jumping once per block.
+
+    With settings that hold still the response matches the biquad chain:
+    both are bilinear transforms prewarped at the cut-off or centre, and the
+    cut cascades use the same Butterworth section Qs as FilterDesign.
+
+    Coefficients are only recomputed per sample while a setting glides;
+    once it arrives the chain runs on fixed coefficients again. Stages that
+    turn inactive fade out over the same time and are then skipped.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "CoefficientDesigner.h"
+
+class SvfFilterChain
+{
+public:
+    SvfFilterChain() = default;
+
+    // Allocates the filter state for spec.numChannels
+    void prepare(const juce::dsp::ProcessSpec& spec);
+
+    // Clears the filter state and jumps every setting to its target
+    void reset() noexcept;
+
+    // Settings to glide to over smoothingSeconds; the first set after prepare() applies at once. Never allocates.
+    void setTargets(const ChainCoefficients& chainCoefficients) noexcept;
+
+    // Processes up to the prepared number of channels in place. Returns straight away while every stage is inactive.
+    void process(const juce::dsp::ProcessContextReplacing<float>& context) noexcept;
+
+    static constexpr double smoothingSeconds = 0.05;
+
+private:
+    enum Stage
+    {
+        lowCutStage,
+        peakStage,
+        highCutStage,
+        numStages
+    };
+
+    enum class Response
+    {
+        highpass,
+        bell,
+        lowpass
+    };
+
+    static constexpr int maxSections = ChainCoefficients::maxCutSections;
+
+    // Samples per run of per-sample coefficients, so the scratch space has a fixed size
+    static constexpr int chunkSize = 256;
+
+    // k is the damping, 1 / Q; m scales the band-pass output the bell adds to its input
+    struct Section
+    {
+        float a1{ 1.0f }, a2{ 0.0f }, a3{ 0.0f }, k{ 2.0f }, m{ 0.0f };
+    };
+
+    struct State
+    {
+        float ic1{ 0.0f }, ic2{ 0.0f };
+    };
+
+    struct ChannelState
+    {
+        std::array<State, maxSections> lowCut, highCut;
+        State peak;
+    };
+
+    using CutSections = std::array<Section, maxSections>;
+
+    static Section makeSection(float g, float k) noexcept;
+
+    template <Response response>
+    static float tick(float input, const Section& section, State& state) noexcept
+    {
+        auto v3 = input - state.ic2;
+        auto v1 = section.a1 * state.ic1 + section.a2 * v3;
+        auto v2 = state.ic2 + section.a2 * state.ic1 + section.a3 * v3;
+
+        state.ic1 = 2.0f * v1 - state.ic1;
+        state.ic2 = 2.0f * v2 - state.ic2;
+
+        if constexpr (response == Response::highpass)
+            return input - section.k * v1 - v2;
+        else if constexpr (response == Response::lowpass)
+            return v2;
+        else
+            return input + section.m * v1;
+    }
+
+    // Runs numSections sections over one channel. sectionStride is 0 for fixed coefficients;
+    // amounts is null while the stage is fully in, otherwise the per-sample wet amount.
+    template <Response response>
+    static void processStage(float* samples, int numSamples, const Section* sections, int sectionStride,
+                             int numSections, State* states, const float* amounts) noexcept;
+
+    // tan(pi f / fs), with the cut-off kept clear of Nyquist
+    float prewarp(float frequency) const noexcept;
+
+    void updateCut(CutSections& sections, const std::array<float, maxSections>& dampings, int numSections, float frequency) const noexcept;
+    Section makePeak(float frequency, float gainInDecibels, float quality) const noexcept;
+    void updateFixedSections() noexcept;
+
+    static void setTarget(juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative>& value, float target, bool jump) noexcept;
+    static void setTarget(juce::SmoothedValue<float>& value, float target, bool jump) noexcept;
+
+    // Butterworth damping of each section of a cut with numSections sections
+    static void setDampings(std::array<float, maxSections>& dampings, int numSections) noexcept;
+
+    // Stage that is faded out and no longer run; its settings jump instead of gliding
+    bool isIdle(Stage stage) const noexcept;
+
+    void processChunk(const juce::dsp::AudioBlock<float>& block, int start, int numSamples) noexcept;
+
+    double sampleRate{ 44100.0 };
+    float maxFrequency{ 20000.0f };
+
+    // =======Settings=======
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative> lowCutFrequency, highCutFrequency, peakFrequency, peakQuality;
+    juce::SmoothedValue<float> peakGainInDecibels;
+
+    // How much of each stage's output is used; fades stages in and out when they turn active or inactive
+    std::array<juce::SmoothedValue<float>, numStages> amounts;
+
+    int numLowCut{ 1 }, numHighCut{ 1 };
+    std::array<float, maxSections> lowCutDampings{}, highCutDampings{};
+
+    bool hasTargets{ false };
+
+    // =======Coefficients=======
+    // Used while nothing glides
+    CutSections lowCut, highCut;
+    Section peak;
+
+    // Per sample of the current chunk while something glides
+    std::array<CutSections, chunkSize> lowCutChunk, highCutChunk;
+    std::array<Section, chunkSize> peakChunk;
+    std::array<std::array<float, chunkSize>, numStages> amountChunks;
+
+    std::vector<ChannelState> channelStates;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SvfFilterChain)
+};
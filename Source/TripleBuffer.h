@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    TripleBuffer.h
+
+    Lock-free single-producer/single-consumer handoff of a complete value.
+    The writer fills the back slot and publishes it, the reader picks up the
+    newest published slot. Neither side ever blocks or allocates.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+
+template <typename ValueType>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+
+    // =======Writer side=======
+    // Slot owned by the writer until the next publish()
+    ValueType& getWriteBuffer() noexcept { return buffers[backIndex]; }
+
+    // Hands the write buffer to the reader and takes the previously shared slot back
+    void publish() noexcept
+    {
+        auto previous = shared.exchange(backIndex | newDataFlag, std::memory_order_acq_rel);
+        backIndex = previous & indexMask;
+    }
+
+    // =======Reader side=======
+    // Returns true if a newer value was published since the last call
+    bool pull() noexcept
+    {
+        if ((shared.load(std::memory_order_relaxed) & newDataFlag) == 0)
+            return false;
+
+        auto previous = shared.exchange(frontIndex, std::memory_order_acq_rel);
+        frontIndex = previous & indexMask;
+        return true;
+    }
+
+    // Slot owned by the reader until the next successful pull()
+    const ValueType& getReadBuffer() const noexcept { return buffers[frontIndex]; }
+
+private:
+    static constexpr int indexMask = 3;
+    static constexpr int newDataFlag = 4;
+
+    std::array<ValueType, 3> buffers{};
+
+    int backIndex{ 0 };
+    std::atomic<int> shared{ 1 };
+    int frontIndex{ 2 };
+
+    static_assert(std::atomic<int>::is_always_lock_free, "The handoff index has to be lock-free");
+};